@@ -0,0 +1,72 @@
+#include <benchmark/benchmark.h>
+
+#include <ocgl/algorithm/BFS.h>
+#include <ocgl/algorithm/BFSShortestPaths.h>
+#include <ocgl/model/IndexGraph.h>
+
+#include "RandomGraph.h"
+
+/**
+ * Random graph with 10^5 vertices and 5 * 10^5 edges (average degree 10).
+ */
+template<typename Graph>
+Graph largeRandom()
+{
+  return randomGraph<Graph>(100000, 500000);
+}
+
+template<typename Graph>
+struct CountVisitor : public ocgl::algorithm::BFSVisitor<Graph>
+{
+  void vertex(const Graph&, typename ocgl::GraphTraits<Graph>::Vertex,
+      unsigned int)
+  {
+    ++numVertices;
+  }
+
+  unsigned int numVertices = 0;
+};
+
+template<typename Graph>
+static void bfs_largeRandom(benchmark::State& state)
+{
+  auto g = largeRandom<Graph>();
+  auto source = ocgl::getVertex(g, 0);
+  while (state.KeepRunning()) {
+    CountVisitor<Graph> visitor;
+    ocgl::algorithm::bfs(g, source, visitor);
+    benchmark::DoNotOptimize(visitor.numVertices);
+  }
+  state.SetItemsProcessed(state.iterations() * ocgl::numVertices(g));
+}
+
+// direction optimizing
+template<typename Graph>
+static void bfsDistances_largeRandom(benchmark::State& state)
+{
+  auto g = largeRandom<Graph>();
+  std::vector<typename ocgl::GraphTraits<Graph>::Vertex> sources = {
+    ocgl::getVertex(g, 0)
+  };
+  while (state.KeepRunning())
+    benchmark::DoNotOptimize(ocgl::algorithm::bfsDistances(g, sources));
+  state.SetItemsProcessed(state.iterations() * ocgl::numVertices(g));
+}
+
+template<typename Graph>
+static void BFSShortestPaths_largeRandom(benchmark::State& state)
+{
+  auto g = largeRandom<Graph>();
+  auto source = ocgl::getVertex(g, 0);
+  while (state.KeepRunning()) {
+    ocgl::algorithm::BFSShortestPaths<Graph> paths(g, source);
+    benchmark::DoNotOptimize(paths.distance(source));
+  }
+  state.SetItemsProcessed(state.iterations() * ocgl::numVertices(g));
+}
+
+BENCHMARK_TEMPLATE(bfs_largeRandom, ocgl::model::IndexGraph);
+BENCHMARK_TEMPLATE(bfsDistances_largeRandom, ocgl::model::IndexGraph);
+BENCHMARK_TEMPLATE(BFSShortestPaths_largeRandom, ocgl::model::IndexGraph);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,62 @@
+#include <benchmark/benchmark.h>
+
+#include <ocgl/algorithm/Isomorphisms.h>
+#include <ocgl/GraphStringParser.h>
+#include <ocgl/model/IndexGraph.h>
+
+// small drug-like ring systems and chains
+static const char* library[] = {
+  "*1*****1", "*1*****1*", "*1*****1**", "*1****1", "*1***1", "*1**1",
+  "*1*****1*1*****1", "*1***2*****2*1", "*1***2**12", "*1***2*3*****3*2*1",
+  "**********", "**(*)(*)*", "*1*****1*(*)**1****1", "*1***2*1*****2",
+  "*1*****1**1***(*)**1", "*1****1*1*****1*1****1"
+};
+
+template<typename Graph>
+std::vector<Graph> makeTargets(std::size_t numTargets)
+{
+  std::vector<Graph> targets;
+  targets.reserve(numTargets);
+  auto n = sizeof(library) / sizeof(library[0]);
+  for (std::size_t i = 0; i < numTargets; ++i)
+    targets.push_back(ocgl::GraphStringParser<Graph>::parse(library[i % n]));
+  return targets;
+}
+
+// the number of threads is the benchmark argument, the throughput is
+// reported as targets (items) per second
+template<typename Graph>
+static void hasIsomorphismBatch_benzene(benchmark::State& state)
+{
+  auto query = ocgl::GraphStringParser<Graph>::parse("*1*****1");
+  ocgl::algorithm::MatchPlan<Graph> plan(query);
+  auto targets = makeTargets<Graph>(10000);
+
+  while (state.KeepRunning())
+    benchmark::DoNotOptimize(ocgl::algorithm::hasIsomorphismBatch(plan,
+          targets, state.range(0)));
+
+  state.SetItemsProcessed(state.iterations() * targets.size());
+}
+
+BENCHMARK_TEMPLATE(hasIsomorphismBatch_benzene, ocgl::model::IndexGraph)
+  ->RangeMultiplier(2)->Range(1, 16)->UseRealTime();
+
+template<typename Graph>
+static void countIsomorphismsBatch_benzene(benchmark::State& state)
+{
+  auto query = ocgl::GraphStringParser<Graph>::parse("*1*****1");
+  ocgl::algorithm::MatchPlan<Graph> plan(query);
+  auto targets = makeTargets<Graph>(10000);
+
+  while (state.KeepRunning())
+    benchmark::DoNotOptimize(ocgl::algorithm::countIsomorphismsBatch(plan,
+          targets, state.range(0)));
+
+  state.SetItemsProcessed(state.iterations() * targets.size());
+}
+
+BENCHMARK_TEMPLATE(countIsomorphismsBatch_benzene, ocgl::model::IndexGraph)
+  ->RangeMultiplier(2)->Range(1, 16)->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -0,0 +1,139 @@
+#include <benchmark/benchmark.h>
+
+#include <ocgl/algorithm/DFS.h>
+#include <ocgl/algorithm/BiconnectedComponents.h>
+#include <ocgl/algorithm/ConnectedComponents.h>
+#include <ocgl/algorithm/CycleMembership.h>
+#include <ocgl/model/IndexGraph.h>
+
+#include "RandomGraph.h"
+
+/**
+ * Path with 10^6 vertices (e.g. a long polymer chain).
+ */
+template<typename Graph>
+Graph longPath()
+{
+  const unsigned int numVertices = 1000000;
+
+  Graph g;
+  auto prev = ocgl::addVertex(g);
+  for (unsigned int i = 1; i < numVertices; ++i) {
+    auto v = ocgl::addVertex(g);
+    ocgl::addEdge(g, prev, v);
+    prev = v;
+  }
+
+  return g;
+}
+
+/**
+ * Random graph with 10^5 vertices and 1.5 * 10^5 edges (average degree 3).
+ */
+template<typename Graph>
+Graph largeRandom()
+{
+  return randomGraph<Graph>(100000, 150000);
+}
+
+template<typename Graph>
+struct CountVisitor : public ocgl::algorithm::DFSVisitor<Graph>
+{
+  void vertex(const Graph&, typename ocgl::GraphTraits<Graph>::Vertex)
+  {
+    ++numVertices;
+  }
+
+  unsigned int numVertices = 0;
+};
+
+#define DFS_BENCHMARK(name) \
+  template<typename Graph> \
+  static void dfs_##name(benchmark::State& state) \
+  { \
+    auto g = name<Graph>(); \
+    while (state.KeepRunning()) { \
+      CountVisitor<Graph> visitor; \
+      ocgl::algorithm::dfs(g, visitor); \
+      benchmark::DoNotOptimize(visitor.numVertices); \
+    } \
+    state.SetItemsProcessed(state.iterations() * ocgl::numVertices(g)); \
+  } \
+  BENCHMARK_TEMPLATE(dfs_##name, ocgl::model::IndexGraph);
+
+#define CYCLE_MEMBERSHIP_BENCHMARK(name) \
+  template<typename Graph> \
+  static void cycleMembership_##name(benchmark::State& state) \
+  { \
+    auto g = name<Graph>(); \
+    while (state.KeepRunning()) \
+      benchmark::DoNotOptimize(ocgl::algorithm::cycleMembership(g)); \
+    state.SetItemsProcessed(state.iterations() * ocgl::numVertices(g)); \
+  } \
+  BENCHMARK_TEMPLATE(cycleMembership_##name, ocgl::model::IndexGraph);
+
+/**
+ * Cycle membership and connected components in separate passes.
+ */
+#define SEPARATE_PASSES_BENCHMARK(name) \
+  template<typename Graph> \
+  static void separatePasses_##name(benchmark::State& state) \
+  { \
+    auto g = name<Graph>(); \
+    while (state.KeepRunning()) { \
+      benchmark::DoNotOptimize(ocgl::algorithm::cycleMembership(g)); \
+      benchmark::DoNotOptimize(ocgl::algorithm::connectedComponents(g)); \
+    } \
+    state.SetItemsProcessed(state.iterations() * ocgl::numVertices(g)); \
+  } \
+  BENCHMARK_TEMPLATE(separatePasses_##name, ocgl::model::IndexGraph);
+
+/**
+ * Cycle membership and connected components in a single pass.
+ */
+#define SHARED_PASS_BENCHMARK(name) \
+  template<typename Graph> \
+  static void sharedPass_##name(benchmark::State& state) \
+  { \
+    auto g = name<Graph>(); \
+    while (state.KeepRunning()) { \
+      ocgl::VertexEdgePropertyMap<Graph, bool> cyclic(g); \
+      ocgl::VertexEdgePropertyMap<Graph, unsigned int> components(g); \
+      ocgl::algorithm::impl::CycleMembershipDFSVisitor<Graph> v1(cyclic); \
+      ocgl::algorithm::impl::ConnectedComponentsDFSVisitor<Graph> v2(components); \
+      auto visitor = ocgl::algorithm::combineDFSVisitors(v1, v2); \
+      ocgl::algorithm::dfs(g, visitor); \
+      benchmark::DoNotOptimize(cyclic); \
+      benchmark::DoNotOptimize(components); \
+    } \
+    state.SetItemsProcessed(state.iterations() * ocgl::numVertices(g)); \
+  } \
+  BENCHMARK_TEMPLATE(sharedPass_##name, ocgl::model::IndexGraph);
+
+/**
+ * Components, cycle membership, ring systems, bridges, articulation points
+ * and circuit ranks in a single pass.
+ */
+#define BICONNECTED_COMPONENTS_BENCHMARK(name) \
+  template<typename Graph> \
+  static void biconnectedComponents_##name(benchmark::State& state) \
+  { \
+    auto g = name<Graph>(); \
+    while (state.KeepRunning()) \
+      benchmark::DoNotOptimize(ocgl::algorithm::biconnectedComponents(g)); \
+    state.SetItemsProcessed(state.iterations() * ocgl::numVertices(g)); \
+  } \
+  BENCHMARK_TEMPLATE(biconnectedComponents_##name, ocgl::model::IndexGraph);
+
+DFS_BENCHMARK(longPath);
+DFS_BENCHMARK(largeRandom);
+
+CYCLE_MEMBERSHIP_BENCHMARK(longPath);
+
+SEPARATE_PASSES_BENCHMARK(longPath);
+SHARED_PASS_BENCHMARK(longPath);
+
+BICONNECTED_COMPONENTS_BENCHMARK(longPath);
+BICONNECTED_COMPONENTS_BENCHMARK(largeRandom);
+
+BENCHMARK_MAIN();
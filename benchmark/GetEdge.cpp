@@ -0,0 +1,77 @@
+#include <benchmark/benchmark.h>
+
+#include <ocgl/GraphStringParser.h>
+#include <ocgl/model/IndexGraph.h>
+#include <ocgl/model/CSRGraph.h>
+
+#include "RandomGraph.h"
+#include "pdb_2r4s.h"
+
+/**
+ * Random graph where each vertex pair is connected with probability 1/10
+ * (i.e. average degree numVertices / 10).
+ */
+template<typename Graph>
+Graph highDegree()
+{
+  return randomGraphWithProbability<Graph>(2000, 0.1);
+}
+
+template<typename Graph>
+struct MakeGraph
+{
+  static Graph make(const ocgl::model::IndexGraph &g)
+  {
+    return g;
+  }
+};
+
+template<>
+struct MakeGraph<ocgl::model::CSRGraph>
+{
+  static ocgl::model::CSRGraph make(const ocgl::model::IndexGraph &g)
+  {
+    return ocgl::model::CSRGraph(g);
+  }
+};
+
+// tag type for a CSRGraph with edge lookup
+struct CSRGraphEdgeLookup : public ocgl::model::CSRGraph {};
+
+template<>
+struct MakeGraph<CSRGraphEdgeLookup>
+{
+  static ocgl::model::CSRGraph make(const ocgl::model::IndexGraph &g)
+  {
+    return ocgl::model::CSRGraph(g, true);
+  }
+};
+
+/**
+ * Look up all edges (v, w) and the same number of unconnected vertex pairs.
+ */
+#define GET_EDGE_BENCHMARK(name) \
+  template<typename Graph> \
+  static void getEdge_##name(benchmark::State& state) \
+  { \
+    auto g = MakeGraph<Graph>::make(name<ocgl::model::IndexGraph>()); \
+    std::vector<std::pair<ocgl::VertexIndex, ocgl::VertexIndex>> pairs; \
+    for (auto e : ocgl::getEdges(g)) { \
+      auto v = ocgl::getSource(g, e); \
+      auto w = ocgl::getTarget(g, e); \
+      pairs.push_back(std::make_pair(v, w)); \
+      pairs.push_back(std::make_pair(v, (w + 1) % ocgl::numVertices(g))); \
+    } \
+    while (state.KeepRunning()) \
+      for (auto &p : pairs) \
+        benchmark::DoNotOptimize(ocgl::getEdge(g, p.first, p.second)); \
+    state.SetItemsProcessed(state.iterations() * pairs.size()); \
+  } \
+  BENCHMARK_TEMPLATE(getEdge_##name, ocgl::model::IndexGraph); \
+  BENCHMARK_TEMPLATE(getEdge_##name, ocgl::model::CSRGraph); \
+  BENCHMARK_TEMPLATE(getEdge_##name, CSRGraphEdgeLookup);
+
+GET_EDGE_BENCHMARK(pdb_2r4s);
+GET_EDGE_BENCHMARK(highDegree);
+
+BENCHMARK_MAIN();
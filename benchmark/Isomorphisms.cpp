@@ -0,0 +1,66 @@
+#include <benchmark/benchmark.h>
+
+#include <ocgl/algorithm/Isomorphisms.h>
+#include <ocgl/GraphStringParser.h>
+#include <ocgl/model/IndexGraph.h>
+
+#include "nanotube_9n_9m_80A.h"
+#include "pdb_2r4s.h"
+
+// count the embeddings of naphthalene (2 fused 6-rings) in a large graph
+#define COUNT_ISOMORPHISMS_BENCHMARK(name) \
+  template<typename Graph> \
+  static void countIsomorphisms_##name(benchmark::State& state) \
+  { \
+    auto query = ocgl::GraphStringParser<Graph>::parse("*1***2*****2*1"); \
+    auto g = name<Graph>(); \
+    while (state.KeepRunning()) \
+      benchmark::DoNotOptimize(ocgl::algorithm::countIsomorphisms(query, g)); \
+  } \
+  BENCHMARK_TEMPLATE(countIsomorphisms_##name, ocgl::model::IndexGraph);
+
+// same search, but the candidates are taken from CandidateDomains
+#define COUNT_ISOMORPHISMS_DOMAINS_BENCHMARK(name) \
+  template<typename Graph> \
+  static void countIsomorphismsDomains_##name(benchmark::State& state) \
+  { \
+    auto query = ocgl::GraphStringParser<Graph>::parse("*1***2*****2*1"); \
+    auto g = name<Graph>(); \
+    ocgl::algorithm::MatchPlan<Graph> plan(query); \
+    ocgl::algorithm::CandidateDomains<Graph, Graph> domains(query); \
+    while (state.KeepRunning()) { \
+      domains.compute(g); \
+      ocgl::algorithm::IsomorphismSearch<Graph, Graph> search(plan, g); \
+      search.setDomains(domains); \
+      std::size_t count = 0; \
+      while (search.next()) \
+        ++count; \
+      benchmark::DoNotOptimize(count); \
+    } \
+  } \
+  BENCHMARK_TEMPLATE(countIsomorphismsDomains_##name, ocgl::model::IndexGraph);
+
+// the number of threads is the benchmark argument
+#define COUNT_ISOMORPHISMS_PARALLEL_BENCHMARK(name) \
+  template<typename Graph> \
+  static void countIsomorphismsParallel_##name(benchmark::State& state) \
+  { \
+    auto query = ocgl::GraphStringParser<Graph>::parse("*1***2*****2*1"); \
+    auto g = name<Graph>(); \
+    while (state.KeepRunning()) \
+      benchmark::DoNotOptimize(ocgl::algorithm::countIsomorphismsParallel( \
+            query, g, state.range(0))); \
+  } \
+  BENCHMARK_TEMPLATE(countIsomorphismsParallel_##name, ocgl::model::IndexGraph) \
+    ->RangeMultiplier(2)->Range(1, 16)->UseRealTime();
+
+COUNT_ISOMORPHISMS_BENCHMARK(nanotube_9n_9m_80A);
+COUNT_ISOMORPHISMS_BENCHMARK(pdb_2r4s);
+
+COUNT_ISOMORPHISMS_DOMAINS_BENCHMARK(nanotube_9n_9m_80A);
+COUNT_ISOMORPHISMS_DOMAINS_BENCHMARK(pdb_2r4s);
+
+COUNT_ISOMORPHISMS_PARALLEL_BENCHMARK(nanotube_9n_9m_80A);
+COUNT_ISOMORPHISMS_PARALLEL_BENCHMARK(pdb_2r4s);
+
+BENCHMARK_MAIN();
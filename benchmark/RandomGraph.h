@@ -0,0 +1,53 @@
+#ifndef OCGL_BENCHMARK_RANDOM_GRAPH_H
+#define OCGL_BENCHMARK_RANDOM_GRAPH_H
+
+#include <random>
+
+/**
+ * Random graph with numVertices vertices and numEdges edges (no loops or
+ * parallel edges). The same seed always gives the same graph.
+ */
+template<typename Graph>
+Graph randomGraph(unsigned int numVertices, unsigned int numEdges,
+    unsigned int seed = 42)
+{
+  Graph g;
+  for (unsigned int i = 0; i < numVertices; ++i)
+    ocgl::addVertex(g);
+
+  std::mt19937 generator(seed);
+  std::uniform_int_distribution<unsigned int> random(0, numVertices - 1);
+
+  while (ocgl::numEdges(g) < numEdges) {
+    auto v = ocgl::getVertex(g, random(generator));
+    auto w = ocgl::getVertex(g, random(generator));
+    if (v != w && !ocgl::isValidEdge(g, ocgl::getEdge(g, v, w)))
+      ocgl::addEdge(g, v, w);
+  }
+
+  return g;
+}
+
+/**
+ * Random graph where each vertex pair is connected with a probability.
+ */
+template<typename Graph>
+Graph randomGraphWithProbability(unsigned int numVertices, double probability,
+    unsigned int seed = 42)
+{
+  Graph g;
+  for (unsigned int i = 0; i < numVertices; ++i)
+    ocgl::addVertex(g);
+
+  std::mt19937 generator(seed);
+  std::bernoulli_distribution connect(probability);
+
+  for (unsigned int i = 0; i < numVertices; ++i)
+    for (unsigned int j = i + 1; j < numVertices; ++j)
+      if (connect(generator))
+        ocgl::addEdge(g, ocgl::getVertex(g, i), ocgl::getVertex(g, j));
+
+  return g;
+}
+
+#endif // OCGL_BENCHMARK_RANDOM_GRAPH_H
@@ -26,6 +26,18 @@
   } \
   BENCHMARK_TEMPLATE(function##_##name, ocgl::model::IndexGraph);
 
+// the number of threads is the benchmark argument
+#define RELEVANT_CYCLES_PARALLEL_BENCHMARK(name) \
+  template<typename Graph> \
+  static void relevantCyclesParallel_##name(benchmark::State& state) \
+  { \
+    auto g = name<Graph>(); \
+    while (state.KeepRunning()) \
+      ocgl::algorithm::relevantCyclesParallel(g, state.range(0)); \
+  } \
+  BENCHMARK_TEMPLATE(relevantCyclesParallel_##name, ocgl::model::IndexGraph) \
+    ->RangeMultiplier(2)->Range(1, 16)->UseRealTime();
+
 RELEVANT_CYCLES_BENCHMARK(relevantCycles, nanotube_6n_6m_20A);
 RELEVANT_CYCLES_BENCHMARK(relevantCycles, nanotube_6n_6m_40A);
 RELEVANT_CYCLES_BENCHMARK(relevantCycles, nanotube_6n_6m_60A);
@@ -38,4 +50,16 @@ RELEVANT_CYCLES_BENCHMARK(relevantCycles, nanotube_9n_9m_80A);
 
 RELEVANT_CYCLES_BENCHMARK(relevantCycles, pdb_2r4s);
 
+RELEVANT_CYCLES_PARALLEL_BENCHMARK(nanotube_6n_6m_20A);
+RELEVANT_CYCLES_PARALLEL_BENCHMARK(nanotube_6n_6m_40A);
+RELEVANT_CYCLES_PARALLEL_BENCHMARK(nanotube_6n_6m_60A);
+RELEVANT_CYCLES_PARALLEL_BENCHMARK(nanotube_6n_6m_80A);
+
+RELEVANT_CYCLES_PARALLEL_BENCHMARK(nanotube_9n_9m_20A);
+RELEVANT_CYCLES_PARALLEL_BENCHMARK(nanotube_9n_9m_40A);
+RELEVANT_CYCLES_PARALLEL_BENCHMARK(nanotube_9n_9m_60A);
+RELEVANT_CYCLES_PARALLEL_BENCHMARK(nanotube_9n_9m_80A);
+
+RELEVANT_CYCLES_PARALLEL_BENCHMARK(pdb_2r4s);
+
 BENCHMARK_MAIN();
@@ -3,11 +3,16 @@
 
 #include <ocgl/Contract.h>
 
+#include <algorithm>
 #include <initializer_list>
 #include <iostream>
 #include <vector>
 #include <limits>
 
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
 /**
  * @file BitMatrix.h
  * @brief A bit matrix.
@@ -15,9 +20,84 @@
 
 namespace ocgl {
 
+  namespace impl {
+
+    /**
+     * @brief Count the number of leading 0 bits in a non-zero block.
+     */
+    inline int countLeadingZeros(unsigned long block)
+    {
+#if defined(__GNUC__) || defined(__clang__)
+      return __builtin_clzl(block);
+#else
+      int n = 0;
+      for (unsigned long mask = ~(~0ul >> 1); !(block & mask); mask >>= 1)
+        ++n;
+      return n;
+#endif
+    }
+
+    /**
+     * @brief Count the number of trailing 0 bits in a non-zero block.
+     */
+    inline int countTrailingZeros(unsigned long block)
+    {
+#if defined(__GNUC__) || defined(__clang__)
+      return __builtin_ctzl(block);
+#else
+      int n = 0;
+      for (unsigned long mask = 1; !(block & mask); mask <<= 1)
+        ++n;
+      return n;
+#endif
+    }
+
+    /**
+     * @brief XOR n blocks from src into dst (<tt>dst = dst ^ src</tt>).
+     *
+     * Uses AVX2 or SSE2 when the compiler targets them, the remaining blocks
+     * are handled one at a time.
+     */
+    template<typename Block>
+    void xorBlocks(Block *dst, const Block *src, std::size_t n)
+    {
+      std::size_t k = 0;
+#if defined(__AVX2__)
+      constexpr std::size_t step = sizeof(__m256i) / sizeof(Block);
+      for (; k + step <= n; k += step) {
+        auto a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dst + k));
+        auto b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + k));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + k),
+            _mm256_xor_si256(a, b));
+      }
+#elif defined(__SSE2__)
+      constexpr std::size_t step = sizeof(__m128i) / sizeof(Block);
+      for (; k + step <= n; k += step) {
+        auto a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst + k));
+        auto b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + k));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + k),
+            _mm_xor_si128(a, b));
+      }
+#endif
+      for (; k < n; ++k)
+        dst[k] ^= src[k];
+    }
+
+  } // namespace impl
+
   /**
    * @class BitMatrix BitMatrix.h <ocgl/BitMatrix.h>
    * @brief Matrix over GF(2).
+   *
+   * The bits are stored in row-major order, each row starts at a new block.
+   * Within a block, column 0 is the most significant bit so the leading bit
+   * of a row can be found by counting the leading zeros of the first non-zero
+   * block.
+   *
+   * After eliminate(), the leading bit (pivot column) of each row is cached.
+   * The cache stays valid for all rows that are not modified later, so
+   * eliminateLastRow() and eliminateRow() only need to XOR the pivot rows
+   * (i.e. O(rank * blocks)).
    */
   class BitMatrix
   {
@@ -113,6 +193,8 @@ namespace ocgl {
         PRE_LT(row, rows());
         PRE_LT(col, cols());
 
+        invalidatePivots(row);
+
         auto idx = index(row, col);
         auto block = block_index(idx);
         auto mask = block_mask(idx);
@@ -130,6 +212,8 @@ namespace ocgl {
         PRE_LT(row, rows());
         PRE_LT(col, cols());
 
+        invalidatePivots(row);
+
         auto idx = index(row, col);
         auto block = block_index(idx);
         auto mask = block_mask(idx);
@@ -158,6 +242,7 @@ namespace ocgl {
 
         --m_rows;
         m_data.resize(m_data.size() - blocksPerRow());
+        invalidatePivots(m_rows);
       }
 
       /**
@@ -190,18 +275,9 @@ namespace ocgl {
         PRE_LT(i, rows());
         PRE_LT(j, rows());
 
-        std::vector<Block> tmp(blocksPerRow());
-        // i -> tmp
-        std::copy(m_data.begin() + i * blocksPerRow(),
-                  m_data.begin() + (i + 1) * blocksPerRow(),
-                  tmp.begin());
-        // j -> i
-        std::copy(m_data.begin() + j * blocksPerRow(),
-                  m_data.begin() + (j + 1) * blocksPerRow(),
-                  m_data.begin() + i * blocksPerRow());
-        // tmp -> j
-        std::copy(tmp.begin(), tmp.end(),
-                   m_data.begin() + j * blocksPerRow());
+        invalidatePivots(std::min(i, j));
+
+        std::swap_ranges(rowBegin(i), rowBegin(i) + blocksPerRow(), rowBegin(j));
       }
 
       /**
@@ -214,47 +290,61 @@ namespace ocgl {
        */
       void xorRows(int i, int j)
       {
-        auto iBlock = i * blocksPerRow();
-        auto jBlock = j * blocksPerRow();
-        for (auto k = 0; k < blocksPerRow(); ++k)
-          m_data[iBlock + k] ^= m_data[jBlock + k];
+        invalidatePivots(i);
+
+        impl::xorBlocks(rowBegin(i), rowBegin(j), blocksPerRow());
       }
 
       /**
        * @brief Perform Gaussian elimination.
        *
+       * The result is in row echelon form, the null rows are moved to the
+       * bottom. The leading bits of the non-null rows are cached.
+       *
        * @return The rank of the matrix.
        */
       int eliminate()
       {
+        m_pivots.clear();
+
         int x = 0;
         int y = 0;
 
-        while (x < m_cols && y < m_rows) {
-          // find the next row with a 1 in column x
+        while (y < m_rows) {
+          // find the first row with the smallest leading bit, all rows below
+          // y have leading bit >= x
           int pivot = -1;
-          for (int i = y; i < m_rows; ++i)
-            if (get(i, x)) {
+          int pivotBit = m_cols;
+          for (int i = y; i < m_rows; ++i) {
+            int bit = leadingBit(i, x / BitsPerBlock);
+            if (bit < pivotBit) {
               pivot = i;
-              break;
+              pivotBit = bit;
             }
-
-          // this column is done, continue with next column
-          if (pivot < 0) {
-            ++x;
-            continue;
           }
 
+          // the remaining rows are null
+          if (pivot < 0)
+            break;
+
+          x = pivotBit;
+
           // swap rows if needed
           if (pivot != y)
-            swapRows(pivot, y);
+            std::swap_ranges(rowBegin(pivot), rowBegin(pivot) + blocksPerRow(),
+                rowBegin(y));
 
-          // xor all rows below with pivot row
+          // xor all rows below with pivot row, the blocks before the pivot
+          // block are 0 for these rows
+          auto xBlock = x / BitsPerBlock;
+          auto mask = block_mask(x);
           for (int j = y + 1; j < m_rows; ++j)
-            if (get(j, x))
-              xorRows(j, y);
+            if (rowBegin(j)[xBlock] & mask)
+              impl::xorBlocks(rowBegin(j) + xBlock, rowBegin(y) + xBlock,
+                  blocksPerRow() - xBlock);
 
           // next row
+          m_pivots.push_back(x);
           ++y;
         }
 
@@ -264,14 +354,14 @@ namespace ocgl {
 
       /**
        * @brief Get the column index for the leading bit of a row.
+       *
+       * @return The column index or cols() if the row is null.
        */
       int leadingBit(int row) const
       {
-        auto j = 0;
-        for (; j < m_cols; ++j)
-          if (get(row, j))
-            return j;
-        return j;
+        if (row < static_cast<int>(m_pivots.size()))
+          return m_pivots[row];
+        return leadingBit(row, 0);
       }
 
       /**
@@ -285,21 +375,109 @@ namespace ocgl {
        */
       int eliminateLastRow()
       {
-        for (int y = 0; y < m_rows - 1; ++y) {
-          // find leading bit on current row
-          int x = leadingBit(y);
+        auto last = rowBegin(m_rows - 1);
+        if (!reduce(last, m_rows - 1))
+          return m_rows;
 
-          if (get(m_rows - 1, x))
-            xorRows(m_rows - 1, y);
-        }
+        return m_rows - 1;
+      }
 
-        if (leadingBit(m_rows - 1) == m_cols)
-          return m_rows - 1;
+      /**
+       * @brief Eliminate a row that is not part of the matrix.
+       *
+       * This is the same as eliminateLastRow() but the row is stored outside
+       * the matrix (e.g. created using makeRow()). Since the matrix is not
+       * modified, multiple threads can eliminate their own rows using the
+       * same matrix.
+       *
+       * The matrix is expected to be in row echelon form. The row may have 1
+       * bits in any column, bits in columns without a pivot remain in the
+       * remainder (i.e. the row is not eliminated completely).
+       *
+       * @param row The row, will contain the remainder after elimination.
+       *
+       * @return True if the row is eliminated completely (i.e. the row is a
+       *         linear combination of the matrix rows).
+       */
+      bool eliminateRow(std::vector<Block> &row) const
+      {
+        PRE_EQ(row.size(), blocksPerRow());
 
-        return m_rows;
+        return reduce(row.data(), m_rows);
+      }
+
+      /**
+       * @brief Check if the matrix is in row echelon form with cached leading
+       *        bits.
+       *
+       * This is the case after eliminate() if the null rows are removed and
+       * only insertRow() is used to add rows.
+       */
+      bool isRowEchelon() const
+      {
+        return static_cast<int>(m_pivots.size()) == m_rows;
+      }
+
+      /**
+       * @brief Insert a row if it is linearly independent of the matrix rows.
+       *
+       * The row is eliminated using the matrix rows. If the remainder is not
+       * null, it is inserted at the position that keeps the matrix in row
+       * echelon form. This makes it possible to build a basis incrementally
+       * without calling eliminate() after each row is added.
+       *
+       * @param row The row (e.g. created using makeRow()), will contain the
+       *        remainder after elimination.
+       *
+       * @return True if the row was inserted.
+       *
+       * @pre isRowEchelon()
+       */
+      bool insertRow(std::vector<Block> &row)
+      {
+        PRE_EQ(row.size(), blocksPerRow());
+        PRE(isRowEchelon());
+
+        if (reduce(row.data(), m_rows))
+          return false;
+
+        // find the position for the remainder's leading bit
+        int x = 0;
+        while (!row[x / BitsPerBlock])
+          x += BitsPerBlock;
+        x += impl::countLeadingZeros(row[x / BitsPerBlock]);
+
+        auto y = std::lower_bound(m_pivots.begin(), m_pivots.end(), x) -
+          m_pivots.begin();
+
+        m_data.insert(m_data.begin() + y * blocksPerRow(), row.begin(), row.end());
+        m_pivots.insert(m_pivots.begin() + y, x);
+        ++m_rows;
+
+        return true;
+      }
+
+      /**
+       * @brief Make an external row with all bits set to 0.
+       *
+       * @param row The row to reuse (avoids allocating memory).
+       */
+      void makeRow(std::vector<Block> &row) const
+      {
+        row.assign(blocksPerRow(), 0);
+      }
+
+      /**
+       * @brief Set the bit in column col of an external row to 1.
+       *
+       * @param row The row.
+       * @param col The column.
+       */
+      static void setBit(std::vector<Block> &row, int col)
+      {
+        row[col / BitsPerBlock] |= block_mask(col);
       }
 
-    private:
       /**
        * @brief Get the number of blocks for a single row.
        */
@@ -311,6 +489,77 @@ namespace ocgl {
         return result;
       }
 
+    private:
+      /**
+       * @brief Reduce a row using the first numRows rows of the matrix.
+       *
+       * @return True if the row is reduced to a null row.
+       */
+      bool reduce(Block *row, int numRows) const
+      {
+        auto n = blocksPerRow();
+
+        for (int y = 0; y < numRows; ++y) {
+          // find leading bit on current row
+          int x = leadingBit(y);
+          if (x == m_cols)
+            continue;
+
+          // the blocks before the pivot block are 0 for row y
+          auto xBlock = x / BitsPerBlock;
+          if (row[xBlock] & block_mask(x))
+            impl::xorBlocks(row + xBlock, rowBegin(y) + xBlock, n - xBlock);
+        }
+
+        for (std::size_t k = 0; k < n; ++k)
+          if (row[k])
+            return false;
+
+        return true;
+      }
+
+      /**
+       * @brief Get the leading bit of a row, starting at a given block.
+       *
+       * @param row The row index.
+       * @param firstBlock The blocks before this block must be 0.
+       *
+       * @return The column index or cols() if the row is null.
+       */
+      int leadingBit(int row, std::size_t firstBlock) const
+      {
+        auto begin = rowBegin(row);
+        for (auto k = firstBlock; k < blocksPerRow(); ++k)
+          if (begin[k])
+            return k * BitsPerBlock + impl::countLeadingZeros(begin[k]);
+        return m_cols;
+      }
+
+      /**
+       * @brief Invalidate the cached leading bits for rows >= row.
+       */
+      void invalidatePivots(int row)
+      {
+        if (row < static_cast<int>(m_pivots.size()))
+          m_pivots.resize(row);
+      }
+
+      /**
+       * @brief Get a pointer to the first block of a row.
+       */
+      Block* rowBegin(int row)
+      {
+        return m_data.data() + row * blocksPerRow();
+      }
+
+      /**
+       * @brief Get a pointer to the first block of a row.
+       */
+      const Block* rowBegin(int row) const
+      {
+        return m_data.data() + row * blocksPerRow();
+      }
+
       /**
        * @brief Get the bit index in row-major orer.
        */
@@ -334,7 +583,7 @@ namespace ocgl {
        *
        * @param index The bit index.
        */
-      unsigned long block_mask(std::size_t index) const
+      static unsigned long block_mask(std::size_t index)
       {
         auto mod = index % BitsPerBlock;
         unsigned long result = 1;
@@ -346,6 +595,10 @@ namespace ocgl {
        * @brief The data.
        */
       std::vector<Block> m_data;
+      /**
+       * @brief The cached leading bit for the first rows (see eliminate()).
+       */
+      std::vector<int> m_pivots;
       /**
        * @brief The number of rows.
        */
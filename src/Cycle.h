@@ -124,6 +124,22 @@ namespace ocgl {
     return circuitRank(g, algorithm::numConnectedComponents(g));
   }
 
+  /**
+   * @brief Get the graph circuit rank using a workspace.
+   *
+   * The connected components are counted using a DFS that reuses the
+   * workspace's buffers.
+   *
+   * @param g The graph.
+   * @param workspace The workspace (see algorithm::TraversalWorkspace).
+   */
+  template<typename Graph>
+  unsigned int circuitRank(const Graph &g,
+      algorithm::TraversalWorkspace<Graph> &workspace)
+  {
+    return circuitRank(g, algorithm::numConnectedComponents(g, workspace));
+  }
+
 } // namespace ocgl
 
 #endif // OCGL_CYCLE_H
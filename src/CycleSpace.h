@@ -85,31 +85,85 @@ namespace ocgl {
         addEdgeCycle(vertexCycleToEdgeCycle(m_graph, cycle), update);
       }
 
+      /**
+       * @brief Add an edge cycle if it is not contained in the cycle space.
+       *
+       * Unlike addEdgeCycle(), the cycle is reduced using the current basis
+       * and only added if it is independent. The basis stays in row echelon
+       * form, so no Gaussian elimination of the whole matrix is needed.
+       *
+       * @param cycle The edge cycle.
+       *
+       * @return True if the cycle was added (i.e. it was not contained in the
+       *         cycle space).
+       */
+      bool tryInsertEdgeCycle(const EdgeCycle<Graph> &cycle)
+      {
+        // cycles added using addEdgeCycle(cycle, false)
+        if (!m_B.isRowEchelon())
+          updateMatrix();
+
+        m_B.makeRow(m_scratch);
+        for (auto e : cycle)
+          BitMatrix::setBit(m_scratch, getEdgeIndex(m_graph, e));
+
+        if (!m_B.insertRow(m_scratch))
+          return false;
+
+        for (auto e : cycle)
+          m_cyclicEdges[getEdgeIndex(m_graph, e)] = true;
+
+        return true;
+      }
+
+      /**
+       * @brief Add a vertex cycle if it is not contained in the cycle space.
+       *
+       * @param cycle The vertex cycle.
+       *
+       * @return True if the cycle was added (i.e. it was not contained in the
+       *         cycle space).
+       */
+      bool tryInsertVertexCycle(const VertexCycle<Graph> &cycle)
+      {
+        return tryInsertEdgeCycle(vertexCycleToEdgeCycle(m_graph, cycle));
+      }
+
       /**
        * @brief Check if an edge cycle is contained in the cycle space.
        *
+       * The cycle space is not modified, so multiple threads can check
+       * cycles concurrently as long as each thread uses its own scratch row
+       * and no cycles are added.
+       *
        * @param cycle The edge cycle to check.
+       * @param scratch Memory for the cycle's row (reused to avoid allocations).
        */
-      bool containsEdgeCycle(const EdgeCycle<Graph> &cycle) const
+      bool containsEdgeCycle(const EdgeCycle<Graph> &cycle,
+          std::vector<BitMatrix::Block> &scratch) const
       {
         for (auto e : cycle)
           if (!m_cyclicEdges[getEdgeIndex(m_graph, e)])
             return false;
 
-        // add cycle to copied B as new row
-        int row = m_B.rows();
-        m_B.addRow();
+        // create row for cycle
+        m_B.makeRow(scratch);
         for (auto e : cycle)
-          m_B.set(row, getEdgeIndex(m_graph, e));
-
-        // perform gaussian elimination on copied B
-        int rank = m_B.eliminateLastRow();
+          BitMatrix::setBit(scratch, getEdgeIndex(m_graph, e));
 
-        m_B.popRow();
+        // the cycle is contained in B if the row is eliminated completely
+        return m_B.eliminateRow(scratch);
+      }
 
-        // if the number of rows is unchanged after both matrices have been
-        // eliminated, the cycle is contained in B
-        return rank == m_B.rows();
+      /**
+       * @brief Check if an edge cycle is contained in the cycle space.
+       *
+       * @param cycle The edge cycle to check.
+       */
+      bool containsEdgeCycle(const EdgeCycle<Graph> &cycle) const
+      {
+        std::vector<BitMatrix::Block> scratch;
+        return containsEdgeCycle(cycle, scratch);
       }
 
       /**
@@ -122,6 +176,19 @@ namespace ocgl {
         return containsEdgeCycle(vertexCycleToEdgeCycle(m_graph, cycle));
       }
 
+      /**
+       * @brief Check if a vertex cycle is contained in the cycle space.
+       *
+       * @param cycle The vertex cycle to check.
+       * @param scratch Memory for the cycle's row (reused to avoid allocations).
+       */
+      bool containsVertexCycle(const VertexCycle<Graph> &cycle,
+          std::vector<BitMatrix::Block> &scratch) const
+      {
+        return containsEdgeCycle(vertexCycleToEdgeCycle(m_graph, cycle),
+            scratch);
+      }
+
       /**
        * @brief Check if the currently added cycles form a basis for the cycle
        *        space of the graph.
@@ -155,7 +222,7 @@ namespace ocgl {
       /**
        * @brief The bit matrix.
        */
-      mutable BitMatrix m_B;
+      BitMatrix m_B;
       /**
        * @brief Keep track of cyclic edges.
        */
@@ -164,6 +231,10 @@ namespace ocgl {
        * @brief The graph's circuit rank.
        */
       unsigned int m_circuitRank;
+      /**
+       * @brief Scratch row for tryInsertEdgeCycle().
+       */
+      std::vector<BitMatrix::Block> m_scratch;
   };
 
 } // namespace ocgl
@@ -0,0 +1,198 @@
+#ifndef OCGL_EDGE_LOOKUP_H
+#define OCGL_EDGE_LOOKUP_H
+
+#include <ocgl/GraphTraits.h>
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include <limits>
+
+/**
+ * @file EdgeLookup.h
+ * @brief Hash table to find the edge between two vertices.
+ */
+
+namespace ocgl {
+
+  /**
+   * @class EdgeLookup EdgeLookup.h <ocgl/EdgeLookup.h>
+   * @brief Hash table to find the edge between two vertices.
+   *
+   * The EdgeLookup class maps an unordered pair of vertex indices to an edge
+   * index using an open addressing hash table with linear probing. The table
+   * is sized to keep the load factor below 0.5 so lookups take O(1) expected
+   * time, independent of the vertex degrees.
+   *
+   * Graph models can use this class to implement the optional
+   * find_edge(g, v, w) function (see GraphTraits::hasEdgeLookup).
+   */
+  class EdgeLookup
+  {
+    public:
+      /**
+       * @brief Constructor for an empty table.
+       */
+      EdgeLookup() : m_mask(0), m_size(0)
+      {
+      }
+
+      /**
+       * @brief Constructor.
+       *
+       * @param numEdges The expected number of edges.
+       */
+      EdgeLookup(unsigned int numEdges) : m_mask(0), m_size(0)
+      {
+        reserve(numEdges);
+      }
+
+      /**
+       * @brief Get the null index that is returned when there is no edge.
+       */
+      static constexpr Index nullIndex()
+      {
+        return std::numeric_limits<Index>::max();
+      }
+
+      /**
+       * @brief Get the number of edges in the table.
+       */
+      unsigned int size() const
+      {
+        return m_size;
+      }
+
+      /**
+       * @brief Check if the table is empty.
+       */
+      bool empty() const
+      {
+        return !m_size;
+      }
+
+      /**
+       * @brief Make sure the table can hold numEdges edges without rehashing.
+       *
+       * @param numEdges The number of edges.
+       */
+      void reserve(unsigned int numEdges)
+      {
+        std::size_t capacity = 16;
+        while (capacity < 2 * static_cast<std::size_t>(numEdges))
+          capacity *= 2;
+
+        if (capacity <= m_slots.size())
+          return;
+
+        std::vector<Slot> slots(capacity, Slot{0, nullIndex()});
+        m_slots.swap(slots);
+        m_mask = capacity - 1;
+        m_size = 0;
+
+        for (auto &slot : slots)
+          if (slot.edge != nullIndex())
+            insert(slot.key, slot.edge);
+      }
+
+      /**
+       * @brief Add an edge to the table.
+       *
+       * @param v The source vertex index.
+       * @param w The target vertex index.
+       * @param e The edge index.
+       *
+       * @pre The edge (v, w) is not in the table.
+       */
+      void insert(VertexIndex v, VertexIndex w, EdgeIndex e)
+      {
+        if (2 * (m_size + 1) > m_slots.size())
+          reserve(m_size + 1);
+
+        insert(key(v, w), e);
+      }
+
+      /**
+       * @brief Find the edge between two vertices.
+       *
+       * @param v The source (or target) vertex index.
+       * @param w The target (or source) vertex index.
+       *
+       * @return The edge index or nullIndex() if there is no edge.
+       */
+      EdgeIndex find(VertexIndex v, VertexIndex w) const
+      {
+        if (m_slots.empty())
+          return nullIndex();
+
+        auto k = key(v, w);
+        for (auto i = hash(k); ; i = (i + 1) & m_mask) {
+          const auto &slot = m_slots[i];
+          if (slot.edge == nullIndex())
+            return nullIndex();
+          if (slot.key == k)
+            return slot.edge;
+        }
+      }
+
+      /**
+       * @brief Remove all edges from the table.
+       */
+      void clear()
+      {
+        m_slots.clear();
+        m_mask = 0;
+        m_size = 0;
+      }
+
+    private:
+      struct Slot
+      {
+        std::uint64_t key;
+        EdgeIndex edge;
+      };
+
+      /**
+       * @brief Get the key for an unordered vertex pair.
+       */
+      static std::uint64_t key(VertexIndex v, VertexIndex w)
+      {
+        if (w < v)
+          std::swap(v, w);
+        return (static_cast<std::uint64_t>(v) << 32) | w;
+      }
+
+      /**
+       * @brief Get the home slot for a key (Fibonacci hashing).
+       */
+      std::size_t hash(std::uint64_t k) const
+      {
+        return (k * 0x9E3779B97F4A7C15ull) >> 32 & m_mask;
+      }
+
+      void insert(std::uint64_t k, EdgeIndex e)
+      {
+        auto i = hash(k);
+        while (m_slots[i].edge != nullIndex())
+          i = (i + 1) & m_mask;
+        m_slots[i] = Slot{k, e};
+        ++m_size;
+      }
+
+      /**
+       * @brief The hash table slots.
+       */
+      std::vector<Slot> m_slots;
+      /**
+       * @brief The mask to map hash values to slots (i.e. capacity - 1).
+       */
+      std::size_t m_mask;
+      /**
+       * @brief The number of edges in the table.
+       */
+      unsigned int m_size;
+  };
+
+} // namespace ocgl
+
+#endif // OCGL_EDGE_LOOKUP_H
@@ -80,7 +80,7 @@ namespace ocgl {
    * isValidEdge(g, e)
    *
    * getOther(g, e, v)
-   * getEdge(g, v, w)
+   * getEdge(g, v, w) (uses find_edge(g, v, w) if GraphTraits<Graph>::hasEdgeLookup)
    * isConnected(g, v, w)
    *
    *
@@ -728,9 +728,54 @@ namespace ocgl {
     return v == t ? s : t;
   }
 
+  namespace impl {
+
+    /**
+     * @brief Check if a graph model provides the find_edge(g, v, w) function.
+     *
+     * Graph models advertise this by defining a static constexpr bool
+     * GraphTraits<Graph>::hasEdgeLookup member that is true.
+     */
+    template<typename Graph, typename = void>
+    struct HasEdgeLookup : std::false_type {};
+
+    template<typename Graph>
+    struct HasEdgeLookup<Graph, typename std::enable_if<
+        GraphTraits<Graph>::hasEdgeLookup>::type> : std::true_type {};
+
+    template<typename Graph>
+    typename GraphTraits<Graph>::Edge getEdge(const Graph &g,
+        typename GraphTraits<Graph>::Vertex v,
+        typename GraphTraits<Graph>::Vertex w, std::true_type)
+    {
+      return find_edge(g, v, w);
+    }
+
+    template<typename Graph>
+    typename GraphTraits<Graph>::Edge getEdge(const Graph &g,
+        typename GraphTraits<Graph>::Vertex v,
+        typename GraphTraits<Graph>::Vertex w, std::false_type)
+    {
+      for (auto e : getIncident(g, v)) {
+        auto s = getSource(g, e);
+        auto t = getTarget(g, e);
+
+        if ((v == s && w == t) || (v == t && w == s))
+          return e;
+      }
+
+      return nullEdge<Graph>();
+    }
+
+  } // namespace impl
+
   /**
    * @brief Get the edge between two vertices.
    *
+   * If the graph model provides an edge lookup (i.e.
+   * GraphTraits<Graph>::hasEdgeLookup is true), the model's find_edge(g, v, w)
+   * function is used. Otherwise, the incident edges of v are searched.
+   *
    * @param g The graph.
    * @param v One of the vertices.
    * @param w One of the vertices.
@@ -746,15 +791,7 @@ namespace ocgl {
     PRE(isValidVertex(g, v));
     PRE(isValidVertex(g, w));
 
-    for (auto e : getIncident(g, v)) {
-      auto s = getSource(g, e);
-      auto t = getTarget(g, e);
-
-      if ((v == s && w == t) || (v == t && w == s))
-        return e;
-    }
-
-    return nullEdge<Graph>();
+    return impl::getEdge(g, v, w, impl::HasEdgeLookup<Graph>());
   }
 
   /**
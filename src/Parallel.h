@@ -0,0 +1,166 @@
+#ifndef OCGL_PARALLEL_H
+#define OCGL_PARALLEL_H
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @file Parallel.h
+ * @brief Work-stealing parallel loop.
+ */
+
+namespace ocgl {
+
+  /**
+   * @brief Get the number of threads to use when 0 threads are requested.
+   *
+   * @return The number of hardware threads (at least 1).
+   */
+  inline unsigned int hardwareThreads()
+  {
+    return std::max(1u, std::thread::hardware_concurrency());
+  }
+
+  namespace impl {
+
+    /**
+     * @brief A range of work items owned by a single worker.
+     *
+     * The owner takes items from the front of the range, other workers steal
+     * half of the remaining items from the back.
+     */
+    struct WorkRange
+    {
+      std::mutex mutex;
+      std::size_t begin = 0;
+      std::size_t end = 0;
+
+      /**
+       * @brief Take the next item from the front.
+       */
+      bool pop(std::size_t &item)
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (begin == end)
+          return false;
+        item = begin++;
+        return true;
+      }
+
+      /**
+       * @brief Steal half of the remaining items from the back.
+       */
+      bool steal(std::size_t &stolenBegin, std::size_t &stolenEnd)
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (begin == end)
+          return false;
+        stolenEnd = end;
+        end -= (end - begin + 1) / 2;
+        stolenBegin = end;
+        return true;
+      }
+    };
+
+  } // namespace impl
+
+  /**
+   * @brief Call a function for all work items in [0, numItems) using multiple
+   * threads.
+   *
+   * The work items are initially divided in contiguous ranges, one for each
+   * thread. A thread that runs out of work steals half of the remaining items
+   * of another thread. This balances the load when the cost of the work items
+   * varies (e.g. the shortest paths from each vertex in a graph).
+   *
+   * The function is called as func(item, thread) where thread is in the range
+   * [0, numThreads). The thread index can be used to give each thread its own
+   * scratch memory. The order in which items are processed is not specified,
+   * so results should be stored per item to get a deterministic result.
+   *
+   * If the function throws an exception, the remaining items are skipped and
+   * the (first) exception is rethrown after all threads have finished.
+   *
+   * @param numItems The number of work items.
+   * @param numThreads The number of threads, 0 to use hardwareThreads().
+   * @param func Function object with signature void(std::size_t, unsigned int).
+   */
+  template<typename Function>
+  void parallelFor(std::size_t numItems, unsigned int numThreads, Function func)
+  {
+    if (!numThreads)
+      numThreads = hardwareThreads();
+    numThreads = static_cast<unsigned int>(std::min<std::size_t>(numThreads,
+          std::max<std::size_t>(numItems, 1)));
+
+    // run in calling thread
+    if (numThreads == 1) {
+      for (std::size_t i = 0; i < numItems; ++i)
+        func(i, 0u);
+      return;
+    }
+
+    std::vector<impl::WorkRange> ranges(numThreads);
+    for (unsigned int t = 0; t < numThreads; ++t) {
+      ranges[t].begin = numItems * t / numThreads;
+      ranges[t].end = numItems * (t + 1) / numThreads;
+    }
+
+    std::atomic<bool> failed(false);
+    std::exception_ptr exception;
+    std::mutex exceptionMutex;
+
+    auto worker = [&] (unsigned int t) {
+      try {
+        auto &own = ranges[t];
+        std::size_t item;
+
+        while (!failed) {
+          if (own.pop(item)) {
+            func(item, t);
+            continue;
+          }
+
+          // steal from the other threads
+          bool stolen = false;
+          for (unsigned int i = 1; i < numThreads && !stolen; ++i) {
+            std::size_t begin, end;
+            if (ranges[(t + i) % numThreads].steal(begin, end)) {
+              std::lock_guard<std::mutex> lock(own.mutex);
+              own.begin = begin;
+              own.end = end;
+              stolen = true;
+            }
+          }
+
+          if (!stolen)
+            break;
+        }
+      } catch (...) {
+        std::lock_guard<std::mutex> lock(exceptionMutex);
+        if (!exception)
+          exception = std::current_exception();
+        failed = true;
+      }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(numThreads - 1);
+    for (unsigned int t = 1; t < numThreads; ++t)
+      threads.emplace_back(worker, t);
+    worker(0);
+
+    for (auto &thread : threads)
+      thread.join();
+
+    if (exception)
+      std::rethrow_exception(exception);
+  }
+
+} // namespace ocgl
+
+#endif // OCGL_PARALLEL_H
@@ -4,6 +4,7 @@
 #include <ocgl/GraphTraits.h>
 
 #include <vector>
+#include <limits>
 
 /**
  * @file PropertyMap.h
@@ -251,6 +252,39 @@ namespace ocgl {
       EdgePropertyMap<Graph, T> edges;
   };
 
+  /**
+   * @brief Update a property map after the graph's indices have changed.
+   *
+   * The property for old index i is moved to index remap[i]. Properties for
+   * which remap[i] is std::numeric_limits<Index>::max() are removed. The
+   * remap table is required to preserve the relative order of the remaining
+   * indices (e.g. the tables returned by model::compact()) so this can be
+   * done in place.
+   *
+   * @param map The property map.
+   * @param remap The old to new index map.
+   *
+   * @pre map.map().size() == remap.size()
+   */
+  template<typename Graph, typename T, typename VertexOrEdgeTag>
+  void remapPropertyMap(PropertyMap<Graph, T, VertexOrEdgeTag> &map,
+      const std::vector<Index> &remap)
+  {
+    PRE_EQ(map.map().size(), remap.size());
+
+    auto &props = map.map();
+    std::size_t size = 0;
+    for (std::size_t i = 0; i < remap.size(); ++i) {
+      if (remap[i] == std::numeric_limits<Index>::max())
+        continue;
+      PRE_EQ(remap[i], size);
+      if (remap[i] != i)
+        props[remap[i]] = props[i];
+      ++size;
+    }
+    props.resize(size);
+  }
+
 } // namespace ocgl
 
 #endif // OCGL_PROPERTY_MAP_H
@@ -0,0 +1,501 @@
+#ifndef OCGL_ALGORITHM_BFS_H
+#define OCGL_ALGORITHM_BFS_H
+
+#include <ocgl/PropertyMap.h>
+#include <ocgl/algorithm/TraversalWorkspace.h>
+
+#include <limits>
+#include <vector>
+
+/**
+ * @file BFS.h
+ * @brief Breadth-first search algorithms.
+ */
+
+namespace ocgl {
+
+  namespace algorithm {
+
+    /**
+     * @brief Depth limit for a breadth-first search without a limit.
+     */
+    constexpr unsigned int bfsNoDepthLimit = std::numeric_limits<unsigned int>::max();
+
+    /**
+     * @class BFSVisitor BFS.h <ocgl/algorithm/BFS.h>
+     * @brief Base class for breadth first search (BFS) visitors.
+     */
+    template<typename Graph>
+    struct BFSVisitor
+    {
+      /**
+       * @brief The vertex type.
+       */
+      using Vertex = typename GraphTraits<Graph>::Vertex;
+      /**
+       * @brief The edge type.
+       */
+      using Edge = typename GraphTraits<Graph>::Edge;
+
+      /**
+       * @brief Initialize the visitor.
+       *
+       * This function is called once when the BFS search is started.
+       *
+       * @param g The graph.
+       */
+      void initialize(const Graph &g)
+      {
+        UNUSED(g);
+      }
+
+      /**
+       * @brief Discover a vertex.
+       *
+       * This function is called when a vertex is reached for the first time
+       * (i.e. when it is added to the queue). The vertices are discovered in
+       * order of increasing depth.
+       *
+       * @param g The graph.
+       * @param v The discovered vertex.
+       * @param depth The number of edges between the vertex and the nearest
+       *        source vertex.
+       */
+      void vertex(const Graph &g, Vertex v, unsigned int depth)
+      {
+        UNUSED(g);
+        UNUSED(v);
+        UNUSED(depth);
+      }
+
+      /**
+       * @brief Visit a tree edge.
+       *
+       * This function is called before the edge's target vertex is
+       * discovered.
+       *
+       * @param g The graph.
+       * @param e The tree edge.
+       */
+      void edge(const Graph &g, Edge e)
+      {
+        UNUSED(g);
+        UNUSED(e);
+      }
+
+      /**
+       * @brief Visit a non-tree edge.
+       *
+       * The non-tree edges are the edges to vertices that were already
+       * discovered (i.e. the chords of the BFS spanning forest).
+       *
+       * @param g The graph.
+       * @param e The non-tree edge.
+       */
+      void nonTreeEdge(const Graph &g, Edge e)
+      {
+        UNUSED(g);
+        UNUSED(e);
+      }
+
+      /**
+       * @brief Invoked when all incident edges of a vertex are examined.
+       *
+       * @param g The graph.
+       * @param v The vertex.
+       */
+      void finishVertex(const Graph &g, Vertex v)
+      {
+        UNUSED(g);
+        UNUSED(v);
+      }
+    };
+
+    namespace impl {
+
+      /**
+       * @brief Basic BFS function.
+       *
+       * Only the vertices for which filter(v) returns true are discovered.
+       * The incident edges of vertices at maxDepth are not examined. The
+       * visited markers and the queue are taken from the workspace.
+       */
+      template<typename Graph, typename BFSVisitor, typename VertexFilter>
+      void bfs(const Graph &g,
+          const std::vector<typename GraphTraits<Graph>::Vertex> &sources,
+          BFSVisitor &visitor, unsigned int maxDepth, VertexFilter filter,
+          TraversalWorkspace<Graph> &workspace)
+      {
+        visitor.initialize(g);
+
+        // keep track of visited vertices and edges using the workspace
+        workspace.start(g);
+
+        // the queue, vertices are never removed so head is used to get the
+        // next vertex
+        auto &queue = workspace.queue();
+
+        for (auto source : sources) {
+          PRE(filter(source));
+          // skip duplicate sources
+          if (workspace.isVertexVisited(source))
+            continue;
+          workspace.visitVertex(source);
+          visitor.vertex(g, source, 0);
+          queue.push_back(source);
+        }
+
+        // the vertices in [head, levelEnd) have the current depth
+        unsigned int depth = 0;
+        std::size_t levelEnd = queue.size();
+
+        for (std::size_t head = 0; head < queue.size(); ++head) {
+          if (head == levelEnd) {
+            ++depth;
+            levelEnd = queue.size();
+          }
+
+          auto u = queue[head];
+
+          if (depth < maxDepth)
+            for (auto e : getIncident(g, u)) {
+              // skip already visited edges
+              if (workspace.isEdgeVisited(e))
+                continue;
+
+              auto w = getOther(g, e, u);
+
+              if (workspace.isVertexVisited(w)) {
+                // mark edge as visited
+                workspace.visitEdge(e);
+                // invoke non-tree edge visitor
+                visitor.nonTreeEdge(g, e);
+                continue;
+              }
+
+              if (!filter(w))
+                continue;
+
+              // mark edge and vertex as visited
+              workspace.visitEdge(e);
+              workspace.visitVertex(w);
+              // invoke edge and vertex visitors
+              visitor.edge(g, e);
+              visitor.vertex(g, w, depth + 1);
+
+              queue.push_back(w);
+            }
+
+          // invoke finish vertex visitor
+          visitor.finishVertex(g, u);
+        }
+      }
+
+      /**
+       * @brief Direction-optimizing BFS (Beamer et al.).
+       *
+       * Small frontiers are expanded top-down (the frontier's edges are
+       * scanned). When the frontier's edges outnumber the unvisited edges
+       * divided by alpha, the search switches to bottom-up: each unvisited
+       * vertex scans its neighbours for one in the frontier (stored as a
+       * bitmap) and stops at the first one. The search switches back to
+       * top-down when the frontier has less than n / beta vertices.
+       */
+      template<typename Graph, typename VertexFilter>
+      void bfsDistances(const Graph &g,
+          const std::vector<typename GraphTraits<Graph>::Vertex> &sources,
+          VertexPropertyMap<Graph, unsigned int> &dist, unsigned int maxDepth,
+          VertexFilter filter)
+      {
+        using Vertex = typename GraphTraits<Graph>::Vertex;
+
+        const unsigned int alpha = 14;
+        const unsigned int beta = 24;
+        const auto infinity = std::numeric_limits<unsigned int>::max();
+        auto n = numVertices(g);
+
+        std::vector<Vertex> frontier, next;
+        std::vector<bool> inFrontier;
+
+        // the number of edge endpoints in the frontier and unvisited vertices
+        std::size_t frontierEdges = 0;
+        std::size_t unvisitedEdges = 2 * numEdges(g);
+
+        for (auto source : sources) {
+          PRE(filter(source));
+          if (dist[source] == 0)
+            continue;
+          dist[source] = 0;
+          frontier.push_back(source);
+          frontierEdges += getDegree(g, source);
+        }
+        unvisitedEdges -= frontierEdges;
+
+        bool bottomUp = false;
+        for (unsigned int depth = 0; !frontier.empty() && depth < maxDepth;
+            ++depth) {
+          if (!bottomUp && frontierEdges > unvisitedEdges / alpha)
+            bottomUp = true;
+          else if (bottomUp && frontier.size() < n / beta)
+            bottomUp = false;
+
+          next.clear();
+
+          if (bottomUp) {
+            inFrontier.assign(n, false);
+            for (auto u : frontier)
+              inFrontier[getVertexIndex(g, u)] = true;
+
+            for (auto v : getVertices(g)) {
+              if (dist[v] != infinity || !filter(v))
+                continue;
+
+              for (auto w : getAdjacent(g, v))
+                if (inFrontier[getVertexIndex(g, w)]) {
+                  dist[v] = depth + 1;
+                  next.push_back(v);
+                  break;
+                }
+            }
+          } else {
+            for (auto u : frontier)
+              for (auto w : getAdjacent(g, u)) {
+                if (dist[w] != infinity || !filter(w))
+                  continue;
+
+                dist[w] = depth + 1;
+                next.push_back(w);
+              }
+          }
+
+          frontierEdges = 0;
+          for (auto v : next)
+            frontierEdges += getDegree(g, v);
+          unvisitedEdges -= frontierEdges;
+
+          frontier.swap(next);
+        }
+      }
+
+    } // namespace impl
+
+    /**
+     * @brief Perform a breadth-first search on a graph (BFS).
+     *
+     * The search starts at the source vertex and visits the vertices in
+     * order of increasing depth (i.e. the number of edges from source).
+     * Every edge in the source's component is visited once, either as tree
+     * edge or as non-tree edge.
+     *
+     * This function makes use of a visitor functor to allow actions to be
+     * performed. Visitors can be implemented by inheriting the BFSVisitor
+     * class and reimplementing the required functions.
+     *
+     * @param g The graph.
+     * @param source The source vertex.
+     * @param visitor The BFS visitor.
+     * @param maxDepth The maximum depth. The vertices at maxDepth are
+     *        discovered and finished, but their edges are not examined.
+     */
+    template<typename Graph, typename BFSVisitor>
+    void bfs(const Graph &g, typename GraphTraits<Graph>::Vertex source,
+        BFSVisitor &visitor, unsigned int maxDepth = bfsNoDepthLimit)
+    {
+      TraversalWorkspace<Graph> workspace;
+      bfs(g, source, visitor, workspace, maxDepth);
+    }
+
+    /**
+     * @brief Perform a breadth-first search using a workspace.
+     *
+     * Same as bfs(g, source, visitor, maxDepth) but the visited markers and
+     * the queue are reused from the workspace instead of allocated.
+     *
+     * @param g The graph.
+     * @param source The source vertex.
+     * @param visitor The BFS visitor.
+     * @param workspace The workspace.
+     * @param maxDepth The maximum depth.
+     */
+    template<typename Graph, typename BFSVisitor>
+    void bfs(const Graph &g, typename GraphTraits<Graph>::Vertex source,
+        BFSVisitor &visitor, TraversalWorkspace<Graph> &workspace,
+        unsigned int maxDepth = bfsNoDepthLimit)
+    {
+      impl::bfs(g, std::vector<typename GraphTraits<Graph>::Vertex>(1, source),
+          visitor, maxDepth, [] (typename GraphTraits<Graph>::Vertex) {
+            return true;
+          }, workspace);
+    }
+
+    /**
+     * @brief Perform a breadth-first search from multiple sources.
+     *
+     * All sources have depth 0 and the depth of a vertex is the number of
+     * edges to the nearest source. The sources are discovered in the given
+     * order (duplicates are ignored).
+     *
+     * @param g The graph.
+     * @param sources The source vertices.
+     * @param visitor The BFS visitor.
+     * @param maxDepth The maximum depth.
+     */
+    template<typename Graph, typename BFSVisitor>
+    void bfs(const Graph &g,
+        const std::vector<typename GraphTraits<Graph>::Vertex> &sources,
+        BFSVisitor &visitor, unsigned int maxDepth = bfsNoDepthLimit)
+    {
+      TraversalWorkspace<Graph> workspace;
+      bfs(g, sources, visitor, workspace, maxDepth);
+    }
+
+    /**
+     * @brief Perform a breadth-first search from multiple sources using a
+     *        workspace.
+     *
+     * @param g The graph.
+     * @param sources The source vertices.
+     * @param visitor The BFS visitor.
+     * @param workspace The workspace.
+     * @param maxDepth The maximum depth.
+     */
+    template<typename Graph, typename BFSVisitor>
+    void bfs(const Graph &g,
+        const std::vector<typename GraphTraits<Graph>::Vertex> &sources,
+        BFSVisitor &visitor, TraversalWorkspace<Graph> &workspace,
+        unsigned int maxDepth = bfsNoDepthLimit)
+    {
+      impl::bfs(g, sources, visitor, maxDepth,
+          [] (typename GraphTraits<Graph>::Vertex) { return true; }, workspace);
+    }
+
+    /**
+     * @brief Perform a breadth-first search on the vertices in a mask.
+     *
+     * The vertices that are not in the mask are never discovered and the
+     * edges to these vertices are not visited.
+     *
+     * @param g The graph.
+     * @param sources The source vertices.
+     * @param visitor The BFS visitor.
+     * @param vertexMask The vertex mask.
+     * @param maxDepth The maximum depth.
+     *
+     * @pre vertexMask[source] for all sources
+     */
+    template<typename Graph, typename BFSVisitor>
+    void bfs(const Graph &g,
+        const std::vector<typename GraphTraits<Graph>::Vertex> &sources,
+        BFSVisitor &visitor, const VertexPropertyMap<Graph, bool> &vertexMask,
+        unsigned int maxDepth = bfsNoDepthLimit)
+    {
+      TraversalWorkspace<Graph> workspace;
+      bfs(g, sources, visitor, vertexMask, workspace, maxDepth);
+    }
+
+    /**
+     * @brief Perform a breadth-first search on the vertices in a mask using a
+     *        workspace.
+     *
+     * @param g The graph.
+     * @param sources The source vertices.
+     * @param visitor The BFS visitor.
+     * @param vertexMask The vertex mask.
+     * @param workspace The workspace.
+     * @param maxDepth The maximum depth.
+     *
+     * @pre vertexMask[source] for all sources
+     */
+    template<typename Graph, typename BFSVisitor>
+    void bfs(const Graph &g,
+        const std::vector<typename GraphTraits<Graph>::Vertex> &sources,
+        BFSVisitor &visitor, const VertexPropertyMap<Graph, bool> &vertexMask,
+        TraversalWorkspace<Graph> &workspace,
+        unsigned int maxDepth = bfsNoDepthLimit)
+    {
+      impl::bfs(g, sources, visitor, maxDepth,
+          [&vertexMask] (typename GraphTraits<Graph>::Vertex v) {
+            return vertexMask[v];
+          }, workspace);
+    }
+
+    /**
+     * @brief Perform a breadth-first search on the vertices in a mask.
+     *
+     * @param g The graph.
+     * @param source The source vertex.
+     * @param visitor The BFS visitor.
+     * @param vertexMask The vertex mask.
+     * @param maxDepth The maximum depth.
+     *
+     * @pre vertexMask[source]
+     */
+    template<typename Graph, typename BFSVisitor>
+    void bfs(const Graph &g, typename GraphTraits<Graph>::Vertex source,
+        BFSVisitor &visitor, const VertexPropertyMap<Graph, bool> &vertexMask,
+        unsigned int maxDepth = bfsNoDepthLimit)
+    {
+      bfs(g, std::vector<typename GraphTraits<Graph>::Vertex>(1, source),
+          visitor, vertexMask, maxDepth);
+    }
+
+    /**
+     * @brief Compute the BFS depth of all vertices.
+     *
+     * This is the bulk version of bfs() for large graphs. No visitor is
+     * called, so the search can switch between expanding the frontier
+     * top-down and scanning the unvisited vertices bottom-up (direction
+     * optimizing BFS). The bottom-up steps only examine the edges until a
+     * parent in the frontier is found, which saves most of the edge visits
+     * when the frontier covers a large part of the graph.
+     *
+     * @param g The graph.
+     * @param sources The source vertices.
+     * @param maxDepth The maximum depth.
+     *
+     * @return The number of edges between each vertex and the nearest
+     *         source. The vertices that were not reached have depth
+     *         std::numeric_limits<unsigned int>::max().
+     */
+    template<typename Graph>
+    VertexPropertyMap<Graph, unsigned int> bfsDistances(const Graph &g,
+        const std::vector<typename GraphTraits<Graph>::Vertex> &sources,
+        unsigned int maxDepth = bfsNoDepthLimit)
+    {
+      VertexPropertyMap<Graph, unsigned int> dist(g,
+          std::numeric_limits<unsigned int>::max());
+      impl::bfsDistances(g, sources, dist, maxDepth,
+          [] (typename GraphTraits<Graph>::Vertex) { return true; });
+      return dist;
+    }
+
+    /**
+     * @brief Compute the BFS depth of the vertices in a mask.
+     *
+     * @param g The graph.
+     * @param sources The source vertices.
+     * @param vertexMask The vertex mask.
+     * @param maxDepth The maximum depth.
+     *
+     * @pre vertexMask[source] for all sources
+     */
+    template<typename Graph>
+    VertexPropertyMap<Graph, unsigned int> bfsDistances(const Graph &g,
+        const std::vector<typename GraphTraits<Graph>::Vertex> &sources,
+        const VertexPropertyMap<Graph, bool> &vertexMask,
+        unsigned int maxDepth = bfsNoDepthLimit)
+    {
+      VertexPropertyMap<Graph, unsigned int> dist(g,
+          std::numeric_limits<unsigned int>::max());
+      impl::bfsDistances(g, sources, dist, maxDepth,
+          [&vertexMask] (typename GraphTraits<Graph>::Vertex v) {
+            return vertexMask[v];
+          });
+      return dist;
+    }
+
+  } // namespace algorithm
+
+} // namespace ocgl
+
+#endif // OCGL_ALGORITHM_BFS_H
@@ -0,0 +1,111 @@
+#ifndef OCGL_ALGORITHM_BFS_SHORTEST_PATHS_H
+#define OCGL_ALGORITHM_BFS_SHORTEST_PATHS_H
+
+#include <ocgl/algorithm/ShortestPathTree.h>
+
+#include <vector>
+
+/**
+ * @file BFSShortestPaths.h
+ * @brief Breadth-first search shortest path algorithm.
+ */
+
+namespace ocgl {
+
+  namespace algorithm {
+
+    /**
+     * @class BFSShortestPaths BFSShortestPaths.h <ocgl/algorithm/BFSShortestPaths.h>
+     * @brief Breadth-first search shortest path algorithm.
+     *
+     * When all edges have the same weight (i.e. the distance is the number of
+     * edges), a breadth-first search finds a shortest path from a source vertex
+     * to all other vertices in O(V + E) time. The algorithm is executed when
+     * the constructor is executed. Later, the distances and paths can be
+     * retrieved using the distance() and path() member functions.
+     *
+     * Use Dijkstra for weighted edges.
+     */
+    template<typename Graph>
+    class BFSShortestPaths : public ShortestPathTree<Graph>
+    {
+      public:
+        /**
+         * @brief The vertex type.
+         */
+        using Vertex = typename GraphTraits<Graph>::Vertex;
+
+        /**
+         * @brief Constructor.
+         *
+         * Using this constructor, all vertices will be considered.
+         *
+         * @param g The graph.
+         * @param source The source vertex.
+         */
+        BFSShortestPaths(const Graph &g, Vertex source)
+          : ShortestPathTree<Graph>(g, source)
+        {
+          bfs(static_cast<const VertexPropertyMap<Graph, bool>*>(nullptr));
+        }
+
+        /**
+         * @brief Constructor.
+         *
+         * Using this constructor, only the vertices in the mask will be
+         * considered.
+         *
+         * @param g The graph.
+         * @param source The source vertex.
+         * @param vertexMask The vertex mask.
+         *
+         * @pre vertexMask[source]
+         */
+        BFSShortestPaths(const Graph &g, Vertex source,
+            const VertexPropertyMap<Graph, bool> &vertexMask)
+          : ShortestPathTree<Graph>(g, source)
+        {
+          bfs(&vertexMask);
+        }
+
+      private:
+        void bfs(const VertexPropertyMap<Graph, bool> *vertexMask)
+        {
+          auto &dist = this->m_dist;
+          auto &prev = this->m_prev;
+
+          // the queue, vertices are never removed so head is used to get the
+          // next vertex
+          std::vector<Vertex> Q;
+          Q.reserve(numVertices(this->m_graph));
+
+          // distance from source to source
+          dist[this->m_source] = 0;
+          Q.push_back(this->m_source);
+
+          for (std::size_t head = 0; head < Q.size(); ++head) {
+            Vertex u = Q[head];
+            unsigned int alt = dist[u] + 1;
+
+            for (auto v : getAdjacent(this->m_graph, u)) {
+              if (vertexMask && !(*vertexMask)[v])
+                continue;
+
+              // vertices are visited in order of distance, the first path
+              // found is a shortest path
+              if (dist[v] != this->infinity())
+                continue;
+
+              dist[v] = alt;
+              prev[v] = u;
+              Q.push_back(v);
+            }
+          }
+        }
+    };
+
+  } // namespace algorithm
+
+} // namespace ocgl
+
+#endif // OCGL_ALGORITHM_BFS_SHORTEST_PATHS_H
@@ -1,7 +1,10 @@
 #ifndef OCGL_ALGORITHM_BACKTRACK_H
 #define OCGL_ALGORITHM_BACKTRACK_H
 
-#include <functional>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <vector>
 
 namespace ocgl {
 
@@ -14,32 +17,261 @@ namespace ocgl {
     // next(local)
     // backtrack(local)
 
+    /**
+     * @class BacktrackSearch Backtrack.h <ocgl/algorithm/Backtrack.h>
+     * @brief Explicit stack backtracking search.
+     *
+     * The search keeps the State::LocalState objects on an explicit stack
+     * instead of the call stack. This makes the search depth independent of
+     * the thread's stack size and allows pulling solutions one at a time:
+     *
+     * @code
+     * BacktrackSearch<State> search(state);
+     * while (search.next())
+     *   process(state.solution());
+     * @endcode
+     *
+     * After next() returns true, the state is a goal state. The state must
+     * not be modified between calls to next().
+     *
+     * A search can be limited to a maximum number of nodes (i.e. successful
+     * calls to State::next()) or a maximum time. When a limit is exceeded,
+     * next() returns false, aborted() returns true and the state is restored
+     * to its initial state. The same happens when the stop flag is set.
+     */
     template<typename State>
-    bool backtrack(State &state, std::function<bool(const typename State::Solution&)> visitor)
+    class BacktrackSearch
     {
-      // found a solution?
-      if (state.isGoal())
-        return visitor(state.solution());
+      public:
+        /**
+         * @brief The local state type.
+         */
+        using LocalState = typename State::LocalState;
+        /**
+         * @brief The clock used for the time limit.
+         */
+        using Clock = std::chrono::steady_clock;
 
-      // early backtrack if needed
-      if (state.isDead())
-        return false;
+        /**
+         * @brief Constructor.
+         *
+         * @param state The initial state.
+         * @param maxNodes The maximum number of nodes to visit (0 for no
+         *        limit).
+         * @param maxTime The maximum search time (0 for no limit).
+         */
+        explicit BacktrackSearch(State &state, std::size_t maxNodes = 0,
+            Clock::duration maxTime = Clock::duration::zero())
+          : m_state(state), m_maxNodes(maxNodes), m_maxTime(maxTime),
+            m_stop(nullptr), m_numNodes(0), m_started(false), m_done(false),
+            m_aborted(false), m_applied(false)
+        {
+        }
+
+        /**
+         * @brief Set the node and time limits.
+         *
+         * @param maxNodes The maximum number of nodes to visit (0 for no
+         *        limit).
+         * @param maxTime The maximum search time (0 for no limit).
+         */
+        void setLimits(std::size_t maxNodes,
+            Clock::duration maxTime = Clock::duration::zero())
+        {
+          m_maxNodes = maxNodes;
+          m_maxTime = maxTime;
+        }
+
+        /**
+         * @brief Set a flag that aborts the search when it becomes true.
+         *
+         * This is used to stop searches running in other threads (e.g. when
+         * only the first solution is needed).
+         */
+        void setStopFlag(const std::atomic<bool> *stop)
+        {
+          m_stop = stop;
+        }
+
+        /**
+         * @brief Get the state.
+         */
+        const State& state() const
+        {
+          return m_state;
+        }
+
+        /**
+         * @brief Get the number of visited nodes.
+         */
+        std::size_t numNodes() const
+        {
+          return m_numNodes;
+        }
+
+        /**
+         * @brief Check if the search was aborted because a limit was exceeded.
+         */
+        bool aborted() const
+        {
+          return m_aborted;
+        }
+
+        /**
+         * @brief Check if the search is finished (exhausted, stopped or
+         *        aborted).
+         */
+        bool done() const
+        {
+          return m_done;
+        }
+
+        /**
+         * @brief Search for the next goal state.
+         *
+         * @return True if a goal state was found, false if the search is
+         *         done.
+         */
+        bool next()
+        {
+          if (m_done)
+            return false;
+
+          if (!m_started) {
+            m_started = true;
+            m_startTime = Clock::now();
+
+            if (m_state.isGoal()) {
+              m_done = true;
+              return true;
+            }
+
+            if (m_state.isDead()) {
+              m_done = true;
+              return false;
+            }
+
+            m_stack.push_back(State::local());
+          }
+
+          while (!m_stack.empty()) {
+            auto &top = m_stack.back();
+
+            // undo the pair of the last goal or dead state
+            if (m_applied) {
+              m_state.backtrack(top);
+              m_applied = false;
+            }
+
+            if (isLimitExceeded()) {
+              m_aborted = true;
+              stop();
+              return false;
+            }
+
+            if (!m_state.next(top)) {
+              // all next states tried, undo the parent's pair
+              m_stack.pop_back();
+              m_applied = !m_stack.empty();
+              continue;
+            }
 
-      // local stack state
-      auto local = State::local();
+            ++m_numNodes;
+            m_applied = true;
 
-      // try all next states
-      while (state.next(local)) {
-        if (backtrack(state, visitor)) {
-          state.backtrack(local);
+            if (m_state.isGoal())
+              return true;
+
+            if (m_state.isDead())
+              continue;
+
+            m_stack.push_back(State::local());
+            m_applied = false;
+          }
+
+          m_done = true;
+          return false;
+        }
+
+        /**
+         * @brief Stop the search and restore the state to its initial state.
+         */
+        void stop()
+        {
+          if (m_applied && !m_stack.empty())
+            m_state.backtrack(m_stack.back());
+          if (!m_stack.empty())
+            m_stack.pop_back();
+
+          // all other local states on the stack have a pair that is applied
+          while (!m_stack.empty()) {
+            m_state.backtrack(m_stack.back());
+            m_stack.pop_back();
+          }
+
+          m_applied = false;
+          m_done = true;
+        }
+
+      private:
+        bool isLimitExceeded() const
+        {
+          if (m_stop && m_stop->load(std::memory_order_relaxed))
+            return true;
+
+          if (m_maxNodes && m_numNodes >= m_maxNodes)
+            return true;
+
+          // only check the clock every 1024 nodes
+          if (m_maxTime != Clock::duration::zero() && !(m_numNodes & 1023))
+            return Clock::now() - m_startTime > m_maxTime;
+
+          return false;
+        }
+
+        State &m_state;
+        std::vector<LocalState> m_stack;
+        std::size_t m_maxNodes;
+        Clock::duration m_maxTime;
+        Clock::time_point m_startTime;
+        const std::atomic<bool> *m_stop;
+        std::size_t m_numNodes;
+        bool m_started;
+        bool m_done;
+        bool m_aborted;
+        // true if the local state on top of the stack has a pair applied
+        bool m_applied;
+    };
+
+    // The visitor is called as visitor(state) for each goal state and
+    // returns true to stop the search. The state can be inspected without
+    // building a solution (e.g. to count solutions).
+    template<typename State, typename GoalVisitor>
+    bool backtrackGoals(State &state, GoalVisitor &visitor)
+    {
+      BacktrackSearch<State> search(state);
+
+      while (search.next())
+        if (visitor(static_cast<const State&>(state))) {
+          search.stop();
           return true;
         }
-        state.backtrack(local);
-      }
 
       return false;
     }
 
+    // The visitor is called as visitor(state.solution()) and returns true to
+    // stop the search. It is a template parameter so the call can be inlined.
+    template<typename State, typename Visitor>
+    bool backtrack(State &state, Visitor &visitor)
+    {
+      auto goalVisitor = [&visitor] (const State &goal) {
+        return visitor(goal.solution());
+      };
+
+      return backtrackGoals(state, goalVisitor);
+    }
+
   } // namespace algorithm
 
 } // namespace ocgl
@@ -0,0 +1,269 @@
+#ifndef OCGL_ALGORITHM_BICONNECTED_COMPONENTS_H
+#define OCGL_ALGORITHM_BICONNECTED_COMPONENTS_H
+
+#include <ocgl/algorithm/DFS.h>
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+/**
+ * @file BiconnectedComponents.h
+ * @brief Single-pass ring/chain perception using Tarjan's low-link values.
+ */
+
+namespace ocgl {
+
+  namespace algorithm {
+
+    /**
+     * @brief The ring system of edges that are not in a ring (i.e. bridges).
+     */
+    constexpr unsigned int noRingSystem = std::numeric_limits<unsigned int>::max();
+
+    /**
+     * @class BiconnectedComponentsResult BiconnectedComponents.h <ocgl/algorithm/BiconnectedComponents.h>
+     * @brief The result of biconnectedComponents().
+     *
+     * A biconnected component (block) is a maximal set of edges in which
+     * every two edges lie on a common cycle. A block with a single edge is a
+     * bridge (chain edge), a block with more edges is a ring system (fused
+     * and bridged rings). Rings that only share a vertex (spiro) are in
+     * different ring systems, the shared vertex is an articulation point.
+     */
+    template<typename Graph>
+    struct BiconnectedComponentsResult
+    {
+      /**
+       * @brief Constructor.
+       *
+       * @param g The graph.
+       */
+      BiconnectedComponentsResult(const Graph &g) : components(g),
+          cyclic(g, false), ringSystems(g, noRingSystem), bridges(g, false),
+          articulationPoints(g, false), numRingSystems(0)
+      {
+      }
+
+      /**
+       * @brief Get the number of connected components.
+       */
+      unsigned int numComponents() const
+      {
+        return circuitRanks.size();
+      }
+
+      /**
+       * @brief Get the circuit rank of the graph (i.e. the sum of the
+       *        circuit ranks of the components).
+       */
+      unsigned int circuitRank() const
+      {
+        unsigned int rank = 0;
+        for (auto r : circuitRanks)
+          rank += r;
+        return rank;
+      }
+
+      /**
+       * @brief The connected component of each vertex and edge.
+       */
+      VertexEdgePropertyMap<Graph, unsigned int> components;
+      /**
+       * @brief The cycle membership of each vertex and edge.
+       */
+      VertexEdgePropertyMap<Graph, bool> cyclic;
+      /**
+       * @brief The ring system of each edge (noRingSystem for bridges).
+       */
+      EdgePropertyMap<Graph, unsigned int> ringSystems;
+      /**
+       * @brief True for the edges that are bridges.
+       */
+      EdgePropertyMap<Graph, bool> bridges;
+      /**
+       * @brief True for the vertices whose removal disconnects their
+       *        component.
+       */
+      VertexPropertyMap<Graph, bool> articulationPoints;
+      /**
+       * @brief The circuit rank of each connected component.
+       */
+      std::vector<unsigned int> circuitRanks;
+      /**
+       * @brief The number of ring systems.
+       */
+      unsigned int numRingSystems;
+    };
+
+    namespace impl {
+
+      template<typename Graph>
+      class BiconnectedComponentsDFSVisitor
+      {
+        public:
+          using Vertex = typename GraphTraits<Graph>::Vertex;
+          using Edge = typename GraphTraits<Graph>::Edge;
+
+          BiconnectedComponentsDFSVisitor(
+              BiconnectedComponentsResult<Graph> &result)
+            : m_result(result)
+          {
+          }
+
+          void initialize(const Graph &g)
+          {
+            m_order.resize(numVertices(g));
+            m_low.resize(numVertices(g));
+            m_edges.reserve(numEdges(g));
+            m_time = 0;
+          }
+
+          void component(const Graph&, unsigned int i)
+          {
+            m_current = i;
+            m_result.circuitRanks.push_back(0);
+            // the next vertex is the root of the DFS tree
+            m_root = m_time;
+            m_rootChildren = 0;
+          }
+
+          void vertex(const Graph &g, Vertex v)
+          {
+            auto vi = getVertexIndex(g, v);
+            m_order[vi] = m_low[vi] = m_time++;
+            m_result.components.vertices[v] = m_current;
+          }
+
+          void edge(const Graph&, Edge e)
+          {
+            m_result.components.edges[e] = m_current;
+            m_edges.push_back(e);
+          }
+
+          void backEdge(const Graph &g, Edge e)
+          {
+            // the current vertex is the descendant (i.e. visited last)
+            auto vi = getVertexIndex(g, getSource(g, e));
+            auto wi = getVertexIndex(g, getTarget(g, e));
+            if (m_order[vi] < m_order[wi])
+              std::swap(vi, wi);
+
+            m_low[vi] = std::min(m_low[vi], m_order[wi]);
+
+            m_result.components.edges[e] = m_current;
+            // every back edge closes an independent cycle
+            ++m_result.circuitRanks.back();
+            m_edges.push_back(e);
+          }
+
+          void finishEdge(const Graph &g, Edge e)
+          {
+            // the parent is visited first
+            auto parent = getSource(g, e);
+            auto child = getTarget(g, e);
+            auto pi = getVertexIndex(g, parent);
+            auto ci = getVertexIndex(g, child);
+            if (m_order[ci] < m_order[pi]) {
+              std::swap(parent, child);
+              std::swap(pi, ci);
+            }
+
+            m_low[pi] = std::min(m_low[pi], m_low[ci]);
+
+            // no back edge from the child's subtree reaches above parent
+            if (m_low[ci] < m_order[pi])
+              return;
+
+            if (m_order[pi] != m_root || ++m_rootChildren > 1)
+              m_result.articulationPoints[parent] = true;
+
+            if (m_edges.back() == e) {
+              // block with a single edge
+              m_edges.pop_back();
+              m_result.bridges[e] = true;
+              return;
+            }
+
+            // pop the ring system's edges
+            auto ringSystem = m_result.numRingSystems++;
+            Edge f;
+            do {
+              f = m_edges.back();
+              m_edges.pop_back();
+              m_result.ringSystems[f] = ringSystem;
+              m_result.cyclic.edges[f] = true;
+              m_result.cyclic.vertices[getSource(g, f)] = true;
+              m_result.cyclic.vertices[getTarget(g, f)] = true;
+            } while (f != e);
+          }
+
+        private:
+          // the result
+          BiconnectedComponentsResult<Graph> &m_result;
+          // the DFS order of each vertex (indexed by vertex index)
+          std::vector<unsigned int> m_order;
+          // the lowest DFS order reachable from the vertex's subtree using a
+          // single back edge (indexed by vertex index)
+          std::vector<unsigned int> m_low;
+          // the edges of the blocks that are not finished yet
+          std::vector<Edge> m_edges;
+          // the next DFS order
+          unsigned int m_time;
+          // the current component
+          unsigned int m_current;
+          // the DFS order of the current root
+          unsigned int m_root;
+          // the number of DFS tree children of the current root
+          unsigned int m_rootChildren;
+      };
+
+    } // namespace impl
+
+    /**
+     * @brief Perceive the rings and chains of a graph in a single DFS pass.
+     *
+     * Tarjan's low-link values are used to determine the connected
+     * components, cycle membership, ring systems (biconnected components
+     * with more than one edge), bridges, articulation points and the circuit
+     * rank of each component in O(|V| + |E|). This replaces separate calls
+     * to connectedComponents(), cycleMembership() and circuitRank().
+     *
+     * @code
+     * auto result = biconnectedComponents(g);
+     * for (auto e : getEdges(g))
+     *   if (result.bridges[e])
+     *     ...
+     * @endcode
+     *
+     * @param g The graph.
+     */
+    template<typename Graph>
+    BiconnectedComponentsResult<Graph> biconnectedComponents(const Graph &g)
+    {
+      TraversalWorkspace<Graph> workspace;
+      return biconnectedComponents(g, workspace);
+    }
+
+    /**
+     * @brief Perceive the rings and chains of a graph in a single DFS pass
+     *        using a workspace.
+     *
+     * @param g The graph.
+     * @param workspace The workspace for the DFS (see TraversalWorkspace).
+     */
+    template<typename Graph>
+    BiconnectedComponentsResult<Graph> biconnectedComponents(const Graph &g,
+        TraversalWorkspace<Graph> &workspace)
+    {
+      BiconnectedComponentsResult<Graph> result(g);
+      impl::BiconnectedComponentsDFSVisitor<Graph> visitor(result);
+      dfs(g, visitor, workspace);
+      return result;
+    }
+
+  } // namespace algorithm
+
+} // namespace ocgl
+
+#endif // OCGL_ALGORITHM_BICONNECTED_COMPONENTS_H
@@ -0,0 +1,424 @@
+#ifndef OCGL_ALGORITHM_CANDIDATE_DOMAINS_H
+#define OCGL_ALGORITHM_CANDIDATE_DOMAINS_H
+
+#include <ocgl/BitMatrix.h>
+#include <ocgl/algorithm/CycleMembership.h>
+#include <ocgl/algorithm/MatchPlan.h>
+
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+/**
+ * @file CandidateDomains.h
+ * @brief Candidate graph vertices for each query vertex.
+ */
+
+namespace ocgl {
+
+  namespace algorithm {
+
+    /**
+     * @class TargetVertexData CandidateDomains.h <ocgl/algorithm/CandidateDomains.h>
+     * @brief The per-vertex data of a target graph used by CandidateDomains.
+     *
+     * The degrees and ring flags only depend on the target, so they can be
+     * computed once per target and shared by the domains of many queries
+     * (see MultiQueryMatcher). The memory is reused for many targets.
+     */
+    template<typename Graph>
+    class TargetVertexData
+    {
+      public:
+        /**
+         * @brief Constructor.
+         */
+        TargetVertexData() : m_hasCycles(false)
+        {
+        }
+
+        /**
+         * @brief Compute the degrees, the ring flags are cleared.
+         *
+         * @param graph The graph.
+         */
+        void computeDegrees(const Graph &graph)
+        {
+          m_degrees.resize(numVertices(graph));
+          for (auto v : getVertices(graph))
+            m_degrees[getVertexIndex(graph, v)] = getDegree(graph, v);
+          m_hasCycles = false;
+        }
+
+        /**
+         * @brief Set the ring flags.
+         *
+         * @param graph The graph.
+         * @param cyclic The cycle membership (see cycleMembership()).
+         */
+        void computeCycles(const Graph &graph,
+            const VertexEdgePropertyMap<Graph, bool> &cyclic)
+        {
+          m_cyclic.resize(numVertices(graph));
+          for (auto v : getVertices(graph))
+            m_cyclic[getVertexIndex(graph, v)] = cyclic.vertices[v];
+          m_hasCycles = true;
+        }
+
+        /**
+         * @brief Get the degree of the vertex with index vi.
+         */
+        unsigned int degree(VertexIndex vi) const
+        {
+          return m_degrees[vi];
+        }
+
+        /**
+         * @brief Check if computeCycles() was called.
+         */
+        bool hasCycles() const
+        {
+          return m_hasCycles;
+        }
+
+        /**
+         * @brief Check if the vertex with index vi is in a ring.
+         */
+        bool isCyclic(VertexIndex vi) const
+        {
+          return m_cyclic[vi];
+        }
+
+      private:
+        std::vector<unsigned int> m_degrees;
+        std::vector<bool> m_cyclic;
+        bool m_hasCycles;
+    };
+
+    /**
+     * @class CandidateDomains CandidateDomains.h <ocgl/algorithm/CandidateDomains.h>
+     * @brief Candidate graph vertices for each query vertex.
+     *
+     * The domain of a query vertex u is a bitset of the graph vertices that u
+     * can be mapped to. A graph vertex v is in the domain of u if:
+     *
+     * - The vertex matcher accepts (u, v).
+     * - The degree of v is at least the degree of u.
+     * - If u is in a cycle, v is also in a cycle.
+     *
+     * Optionally, the domains are refined until they are arc consistent: v
+     * is removed from the domain of u if a neighbour w of u has no matching
+     * edge to a neighbour of v in the domain of w. This is repeated until no
+     * more vertices are removed.
+     *
+     * The domains are computed once before the search. VF2State only visits
+     * the graph vertices in the domains, which replaces calling the vertex
+     * matcher for every candidate pair (see VF2State::setDomains()). If a
+     * domain is empty, there are no isomorphisms.
+     *
+     * The object can be reused for many graphs and queries (see setQuery()),
+     * the memory only grows. The query must outlive the domains.
+     */
+    template<typename Query, typename Graph>
+    class CandidateDomains
+    {
+      public:
+        /**
+         * @brief The query vertex type.
+         */
+        using QueryVertex = typename GraphTraits<Query>::Vertex;
+        /**
+         * @brief The graph vertex type.
+         */
+        using GraphVertex = typename GraphTraits<Graph>::Vertex;
+
+        /**
+         * @brief Constructor without query, setQuery() has to be called
+         *        before compute().
+         */
+        CandidateDomains()
+          : m_query(nullptr), m_graph(nullptr), m_blocksPerRow(0),
+            m_hasCycles(false)
+        {
+        }
+
+        /**
+         * @brief Constructor.
+         *
+         * The query's cycle membership is computed once.
+         *
+         * @param query The query graph.
+         */
+        explicit CandidateDomains(const Query &query)
+          : CandidateDomains()
+        {
+          setQuery(query);
+        }
+
+        /**
+         * @brief Set the query and compute its cycle membership.
+         *
+         * @param query The query graph.
+         */
+        void setQuery(const Query &query)
+        {
+          setQuery(query, cycleMembership(query));
+        }
+
+        /**
+         * @brief Set the query using its precomputed cycle membership.
+         *
+         * @param query The query graph.
+         * @param cyclic The query's cycle membership.
+         */
+        void setQuery(const Query &query,
+            const VertexEdgePropertyMap<Query, bool> &cyclic)
+        {
+          m_query = &query;
+          m_queryCyclic.assign(numVertices(query), false);
+          m_hasCycles = false;
+          for (auto u : getVertices(query))
+            if (cyclic.vertices[u]) {
+              m_queryCyclic[getVertexIndex(query, u)] = true;
+              m_hasCycles = true;
+            }
+        }
+
+        /**
+         * @brief Check if the query has cycles (i.e. the target's ring flags
+         *        are needed).
+         */
+        bool queryHasCycles() const
+        {
+          return m_hasCycles;
+        }
+
+        /**
+         * @brief Compute the domains for a graph.
+         *
+         * @param graph The graph (must outlive the domains).
+         * @param vertexMatcher The vertex matcher.
+         * @param edgeMatcher The edge matcher (only used for refining).
+         * @param refine If true, the domains are refined until they are arc
+         *        consistent.
+         */
+        template<typename VertexMatcher = impl::AlwaysMatch,
+                 typename EdgeMatcher = impl::AlwaysMatch>
+        void compute(const Graph &graph,
+            VertexMatcher vertexMatcher = VertexMatcher(),
+            EdgeMatcher edgeMatcher = EdgeMatcher(), bool refine = true)
+        {
+          TargetVertexData<Graph> data;
+          data.computeDegrees(graph);
+          // the graph's cycles are only needed if the query has cycles
+          if (m_hasCycles)
+            data.computeCycles(graph, cycleMembership(graph));
+          compute(graph, data, vertexMatcher, edgeMatcher, refine);
+        }
+
+        /**
+         * @brief Compute the domains for a graph using its precomputed
+         *        per-vertex data.
+         *
+         * @param graph The graph (must outlive the domains).
+         * @param data The graph's degrees and, if the query has cycles, ring
+         *        flags.
+         * @param vertexMatcher The vertex matcher.
+         * @param edgeMatcher The edge matcher (only used for refining).
+         * @param refine If true, the domains are refined until they are arc
+         *        consistent.
+         */
+        template<typename VertexMatcher = impl::AlwaysMatch,
+                 typename EdgeMatcher = impl::AlwaysMatch>
+        void compute(const Graph &graph, const TargetVertexData<Graph> &data,
+            VertexMatcher vertexMatcher = VertexMatcher(),
+            EdgeMatcher edgeMatcher = EdgeMatcher(), bool refine = true)
+        {
+          PRE(!m_hasCycles || data.hasCycles());
+
+          m_graph = &graph;
+          m_blocksPerRow = (numVertices(graph) + BlockBits - 1) / BlockBits;
+          m_blocks.assign(numVertices(query()) * m_blocksPerRow, 0);
+          m_sizes.assign(numVertices(query()), 0);
+
+          for (auto u : getVertices(query())) {
+            auto ui = getVertexIndex(query(), u);
+            auto degree = getDegree(query(), u);
+            for (auto v : getVertices(graph)) {
+              auto vi = getVertexIndex(graph, v);
+              if (data.degree(vi) < degree)
+                continue;
+              if (m_queryCyclic[ui] && !data.isCyclic(vi))
+                continue;
+              if (vertexMatcher(u, v))
+                set(ui, vi);
+            }
+          }
+
+          if (refine)
+            refineDomains(edgeMatcher);
+        }
+
+        /**
+         * @brief Get the query graph.
+         */
+        const Query& query() const
+        {
+          return *m_query;
+        }
+
+        /**
+         * @brief Get the graph of the last call to compute().
+         */
+        const Graph& graph() const
+        {
+          return *m_graph;
+        }
+
+        /**
+         * @brief Check if graph vertex vi is in the domain of query vertex ui.
+         */
+        bool containsIndex(VertexIndex ui, VertexIndex vi) const
+        {
+          return m_blocks[ui * m_blocksPerRow + vi / BlockBits] &
+            (Block(1) << (vi % BlockBits));
+        }
+
+        /**
+         * @brief Check if graph vertex v is in the domain of query vertex u.
+         */
+        bool contains(QueryVertex u, GraphVertex v) const
+        {
+          return containsIndex(getVertexIndex(query(), u),
+              getVertexIndex(graph(), v));
+        }
+
+        /**
+         * @brief Get the number of graph vertices in the domain of u.
+         */
+        unsigned int size(QueryVertex u) const
+        {
+          return m_sizes[getVertexIndex(query(), u)];
+        }
+
+        /**
+         * @brief Check if any domain is empty (i.e. there are no
+         *        isomorphisms).
+         */
+        bool isEmpty() const
+        {
+          for (auto size : m_sizes)
+            if (!size)
+              return true;
+          return false;
+        }
+
+        /**
+         * @brief Get the first graph vertex index >= vi in the domain of ui.
+         *
+         * Empty blocks are skipped, so iterating over a sparse domain does
+         * not visit every graph vertex.
+         *
+         * @return The index or the number of graph vertices if there are no
+         *         more vertices in the domain.
+         */
+        VertexIndex nextCandidate(VertexIndex ui, VertexIndex vi) const
+        {
+          auto n = numVertices(graph());
+          if (vi >= n)
+            return n;
+
+          auto row = m_blocks.data() + ui * m_blocksPerRow;
+          auto b = vi / BlockBits;
+          // ignore the bits before vi
+          auto block = row[b] & (~Block(0) << (vi % BlockBits));
+
+          while (!block) {
+            if (++b == m_blocksPerRow)
+              return n;
+            block = row[b];
+          }
+
+          return b * BlockBits + ocgl::impl::countTrailingZeros(block);
+        }
+
+      private:
+        using Block = unsigned long;
+        static constexpr unsigned int BlockBits =
+          std::numeric_limits<Block>::digits;
+
+        void set(VertexIndex ui, VertexIndex vi)
+        {
+          m_blocks[ui * m_blocksPerRow + vi / BlockBits] |=
+            Block(1) << (vi % BlockBits);
+          ++m_sizes[ui];
+        }
+
+        void reset(VertexIndex ui, VertexIndex vi)
+        {
+          m_blocks[ui * m_blocksPerRow + vi / BlockBits] &=
+            ~(Block(1) << (vi % BlockBits));
+          --m_sizes[ui];
+        }
+
+        /**
+         * @brief Check if every query edge (u, w) can be mapped to a graph
+         *        edge (v, x) with x in the domain of w.
+         */
+        template<typename EdgeMatcher>
+        bool isSupported(QueryVertex u, GraphVertex v,
+            EdgeMatcher &edgeMatcher) const
+        {
+          for (auto e : getIncident(query(), u)) {
+            auto wi = getVertexIndex(query(), getOther(query(), e, u));
+
+            bool supported = false;
+            for (auto f : getIncident(graph(), v))
+              if (containsIndex(wi, getVertexIndex(graph(), getOther(graph(), f, v))) &&
+                  edgeMatcher(e, f)) {
+                supported = true;
+                break;
+              }
+
+            if (!supported)
+              return false;
+          }
+
+          return true;
+        }
+
+        template<typename EdgeMatcher>
+        void refineDomains(EdgeMatcher &edgeMatcher)
+        {
+          auto n = numVertices(graph());
+
+          bool changed = true;
+          while (changed) {
+            changed = false;
+            for (auto u : getVertices(query())) {
+              auto ui = getVertexIndex(query(), u);
+              for (auto vi = nextCandidate(ui, 0); vi < n;
+                  vi = nextCandidate(ui, vi + 1))
+                if (!isSupported(u, getVertex(graph(), vi), edgeMatcher)) {
+                  reset(ui, vi);
+                  changed = true;
+                }
+            }
+          }
+        }
+
+        const Query *m_query;
+        const Graph *m_graph;
+        std::size_t m_blocksPerRow;
+        // row ui contains the domain of query vertex ui
+        std::vector<Block> m_blocks;
+        std::vector<unsigned int> m_sizes;
+        std::vector<bool> m_queryCyclic;
+        bool m_hasCycles;
+    };
+
+  } // namespace algorithm
+
+} // namespace ocgl
+
+#endif // OCGL_ALGORITHM_CANDIDATE_DOMAINS_H
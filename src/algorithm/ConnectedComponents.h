@@ -56,6 +56,17 @@ namespace ocgl {
           VertexEdgePropertyMap<Graph, unsigned int> &m_component;
       };
 
+      template<typename Graph>
+      struct NumConnectedComponentsDFSVisitor : public DFSVisitor<Graph>
+      {
+        void component(const Graph&, unsigned int)
+        {
+          ++numComponents;
+        }
+
+        unsigned int numComponents = 0;
+      };
+
     } // namespace impl
 
 
@@ -68,13 +79,23 @@ namespace ocgl {
     template<typename Graph>
     VertexEdgePropertyMap<Graph, unsigned int> connectedComponents(const Graph &g)
     {
-      // create property map to hold result
+      TraversalWorkspace<Graph> workspace;
+      return connectedComponents(g, workspace);
+    }
+
+    /**
+     * @brief Determine the connected components using a workspace.
+     *
+     * @param g The graph.
+     * @param workspace The workspace for the DFS (see TraversalWorkspace).
+     */
+    template<typename Graph>
+    VertexEdgePropertyMap<Graph, unsigned int> connectedComponents(const Graph &g,
+        TraversalWorkspace<Graph> &workspace)
+    {
       VertexEdgePropertyMap<Graph, unsigned int> result(g);
-      // create DFS visitor
       impl::ConnectedComponentsDFSVisitor<Graph> visitor(result);
-      // run DFS algorithm
-      dfs(g, visitor);
-      // return rsult
+      dfs(g, visitor, workspace);
       return result;
     }
 
@@ -107,6 +128,23 @@ namespace ocgl {
       return numConnectedComponents(connectedComponents(g));
     }
 
+    /**
+     * @brief Determine the number of connected components using a workspace.
+     *
+     * The components are only counted, no property maps are allocated.
+     *
+     * @param g The graph.
+     * @param workspace The workspace for the DFS (see TraversalWorkspace).
+     */
+    template<typename Graph>
+    unsigned int numConnectedComponents(const Graph &g,
+        TraversalWorkspace<Graph> &workspace)
+    {
+      impl::NumConnectedComponentsDFSVisitor<Graph> visitor;
+      dfs(g, visitor, workspace);
+      return visitor.numComponents;
+    }
+
     /**
      * @brief Get a list of connected component subgraphs.
      *
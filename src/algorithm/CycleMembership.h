@@ -31,11 +31,6 @@ namespace ocgl {
             path.reserve(numVertices(g));
           }
 
-          void component(const Graph&, unsigned int)
-          {
-            path.clear();
-          }
-
           void vertex(const Graph&, Vertex v)
           {
             path.push_back(v);
@@ -70,7 +65,7 @@ namespace ocgl {
           }
 
         private:
-          // the current DFS path
+          // the current DFS path (empty when a new component starts)
           std::vector<Vertex> path;
           // map : vertex/edge -> cycle membership
           VertexEdgePropertyMap<Graph, bool> &m_cyclic;
@@ -91,13 +86,25 @@ namespace ocgl {
     template<typename Graph>
     VertexEdgePropertyMap<Graph, bool> cycleMembership(const Graph &graph)
     {
-      // create the vertex/edge property map to hold the result
+      TraversalWorkspace<Graph> workspace;
+      return cycleMembership(graph, workspace);
+    }
+
+    /**
+     * @brief Determine vertex and edge cycle membership using a workspace.
+     *
+     * @param graph The graph.
+     * @param workspace The workspace for the DFS (see TraversalWorkspace).
+     *
+     * @return The vertex and edge cycle membership as property maps.
+     */
+    template<typename Graph>
+    VertexEdgePropertyMap<Graph, bool> cycleMembership(const Graph &graph,
+        TraversalWorkspace<Graph> &workspace)
+    {
       VertexEdgePropertyMap<Graph, bool> result(graph);
-      // create the DFS visitor
       impl::CycleMembershipDFSVisitor<Graph> visitor(result);
-      // run DFS
-      dfs(graph, visitor);
-      // return result
+      dfs(graph, visitor, workspace);
       return result;
     }
 
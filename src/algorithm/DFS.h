@@ -2,6 +2,11 @@
 #define OCGL_ALGORITHM_DFS_H
 
 #include <ocgl/PropertyMap.h>
+#include <ocgl/algorithm/TraversalWorkspace.h>
+
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 /**
  * @file DFS.h
@@ -19,6 +24,12 @@ namespace ocgl {
     /**
      * @class DFSVisitor DFS.h <ocgl/algorithm/DFS.h>
      * @brief Base class for depth first search (DFS) visitors.
+     *
+     * The DFS engine detects at compile time which events a visitor
+     * implements. Events inherited from this class (or missing in visitors
+     * that do not inherit this class) are not invoked, and the engine skips
+     * the bookkeeping that is only needed for these events (e.g. the visited
+     * edge markers are only used to detect back edges).
      */
     template<typename Graph>
     struct DFSVisitor
@@ -129,53 +140,350 @@ namespace ocgl {
     namespace impl {
 
       /**
-       * @brief Basic DFS recursive function.
+       * @brief Define the traits for a DFS visitor event.
+       *
+       * Has<Name>Event<Graph, Visitor> is true if the visitor can be called
+       * with the arguments and the event is not the empty one inherited from
+       * DFSVisitor. invoke<Name>(visitor, g, ...) only calls the event if it is
+       * implemented.
+       */
+#define OCGL_DFS_VISITOR_EVENT(Name, event, ...) \
+      template<typename Graph, typename Visitor, typename = void> \
+      struct IsDefault##Name##Event : std::false_type {}; \
+      \
+      template<typename Graph, typename Visitor> \
+      struct IsDefault##Name##Event<Graph, Visitor, typename std::enable_if< \
+          std::is_same<decltype(&Visitor::event), \
+          decltype(&DFSVisitor<Graph>::event)>::value>::type> \
+        : std::true_type {}; \
+      \
+      template<typename Graph, typename Visitor, typename = void> \
+      struct IsCallable##Name##Event : std::false_type {}; \
+      \
+      template<typename Graph, typename Visitor> \
+      struct IsCallable##Name##Event<Graph, Visitor, decltype(void( \
+          std::declval<Visitor&>().event(__VA_ARGS__)))> \
+        : std::true_type {}; \
+      \
+      template<typename Graph, typename Visitor> \
+      struct Has##Name##Event : std::integral_constant<bool, \
+          IsCallable##Name##Event<Graph, Visitor>::value && \
+          !IsDefault##Name##Event<Graph, Visitor>::value> {}; \
+      \
+      template<typename Graph, typename Visitor, typename ...Args> \
+      void invoke##Name(std::true_type, Visitor &visitor, const Graph &g, \
+          Args&&... args) \
+      { \
+        visitor.event(g, std::forward<Args>(args)...); \
+      } \
+      \
+      template<typename Graph, typename Visitor, typename ...Args> \
+      void invoke##Name(std::false_type, Visitor&, const Graph&, Args&&...) \
+      { \
+      } \
+      \
+      template<typename Graph, typename Visitor, typename ...Args> \
+      void invoke##Name(Visitor &visitor, const Graph &g, Args&&... args) \
+      { \
+        invoke##Name(Has##Name##Event<Graph, Visitor>(), visitor, g, \
+            std::forward<Args>(args)...); \
+      }
+
+#define OCGL_DFS_GRAPH std::declval<const Graph&>()
+#define OCGL_DFS_VERTEX std::declval<typename GraphTraits<Graph>::Vertex>()
+#define OCGL_DFS_EDGE std::declval<typename GraphTraits<Graph>::Edge>()
+
+      OCGL_DFS_VISITOR_EVENT(Initialize, initialize, OCGL_DFS_GRAPH)
+      OCGL_DFS_VISITOR_EVENT(Component, component, OCGL_DFS_GRAPH, 0u)
+      OCGL_DFS_VISITOR_EVENT(Vertex, vertex, OCGL_DFS_GRAPH, OCGL_DFS_VERTEX)
+      OCGL_DFS_VISITOR_EVENT(Edge, edge, OCGL_DFS_GRAPH, OCGL_DFS_EDGE)
+      OCGL_DFS_VISITOR_EVENT(BackEdge, backEdge, OCGL_DFS_GRAPH, OCGL_DFS_EDGE)
+      OCGL_DFS_VISITOR_EVENT(FinishEdge, finishEdge, OCGL_DFS_GRAPH,
+          OCGL_DFS_EDGE)
+      OCGL_DFS_VISITOR_EVENT(FinishVertex, finishVertex, OCGL_DFS_GRAPH,
+          OCGL_DFS_VERTEX)
+
+#undef OCGL_DFS_GRAPH
+#undef OCGL_DFS_VERTEX
+#undef OCGL_DFS_EDGE
+#undef OCGL_DFS_VISITOR_EVENT
+
+      /**
+       * @brief Basic DFS function.
+       *
+       * The search uses an explicit stack instead of recursion, so the depth
+       * of the search tree is not limited by the thread's stack size (e.g.
+       * long chains and biopolymers). Each frame resumes the iteration over
+       * the incident edges of its vertex, so the visitor events are invoked
+       * in the same order as a recursive DFS.
+       *
+       * The visited markers and the stack are taken from the workspace, the
+       * traversal must be started by the caller.
        */
       template<typename Graph, typename DFSVisitor>
       void dfs(const Graph &g, typename GraphTraits<Graph>::Vertex v,
-          DFSVisitor &visitor, VertexEdgePropertyMap<Graph, bool> &visited)
+          DFSVisitor &visitor, TraversalWorkspace<Graph> &workspace)
       {
+        // the visited edges are only needed to find the back edges, without
+        // them, an edge to a visited vertex is simply skipped
+        constexpr bool markEdges = HasBackEdgeEvent<Graph, DFSVisitor>::value;
+
+        auto &stack = workspace.stack();
+
         // mark vertex as visited
-        visited.vertices[v] = true;
+        workspace.visitVertex(v);
         // invoke vertex visitor
-        visitor.vertex(g, v);
+        invokeVertex(visitor, g, v);
+
+        auto incident = getIncident(g, v);
+        stack.push_back(DFSFrame<Graph>{v, nullEdge<Graph>(), incident.begin(),
+            incident.end()});
 
-        // call impl::dfs for all unvisited neighbors of v
-        for (auto e : getIncident(g, v)) {
-          // skip already visited edges
-          if (visited.edges[e])
+        while (!stack.empty()) {
+          auto &frame = stack.back();
+
+          if (frame.next == frame.end) {
+            auto u = frame.vertex;
+            auto e = frame.edge;
+            stack.pop_back();
+
+            // invoke finish vertex visitor
+            invokeFinishVertex(visitor, g, u);
+            // invoke finish edge visitor (the root has no edge)
+            if (!stack.empty())
+              invokeFinishEdge(visitor, g, e);
             continue;
+          }
 
-          auto w = getOther(g, e, v);
+          auto e = *frame.next;
+          ++frame.next;
 
-          if (visited.vertices[w]) {
-            // if this edge has not been visited before, a back edge has been found
-            if (!visited.edges[e]) {
-              // invoke back edge visitor
-              visitor.backEdge(g, e);
-              // mark edge as visited
-              visited.edges[e] = true;
-            }
+          if (markEdges) {
+            // skip already visited edges
+            if (workspace.isEdgeVisited(e))
+              continue;
+            // mark edge as visited
+            workspace.visitEdge(e);
+          }
+
+          auto w = getOther(g, e, frame.vertex);
+
+          if (workspace.isVertexVisited(w)) {
+            // a back edge has been found (or the tree edge to the parent if
+            // the edges are not marked)
+            invokeBackEdge(visitor, g, e);
             continue;
           }
 
-          // mark edge as visited
-          visited.edges[e] = true;
           // invoke edge visitor
-          visitor.edge(g, e);
+          invokeEdge(visitor, g, e);
+
+          // descend into w (frame is invalidated by push_back)
+          workspace.visitVertex(w);
+          invokeVertex(visitor, g, w);
+          auto wIncident = getIncident(g, w);
+          stack.push_back(DFSFrame<Graph>{w, e, wIncident.begin(),
+              wIncident.end()});
+        }
+      }
+
+    } // namespace impl
+
+    /**
+     * @class CompositeDFSVisitor DFS.h <ocgl/algorithm/DFS.h>
+     * @brief Visitor that forwards the DFS events to two visitors.
+     *
+     * Composite visitors allow several analyses to share a single DFS pass.
+     * Each event is forwarded to the first visitor and then to the second
+     * visitor, but only to the visitors that implement it. If neither
+     * visitor implements an event, the composite does not implement it
+     * either and the engine skips it. Use combineDFSVisitors() to combine
+     * more than two visitors.
+     *
+     * The visitor types may be references, in which case only a reference
+     * to the visitor is stored.
+     */
+    template<typename First, typename Second>
+    class CompositeDFSVisitor
+    {
+        using FirstVisitor = typename std::remove_reference<First>::type;
+        using SecondVisitor = typename std::remove_reference<Second>::type;
+
+        // only implement the events that one of the visitors implements
+        template<template<typename, typename> class Has, typename Graph>
+        using EnableIfAny = typename std::enable_if<
+          Has<Graph, FirstVisitor>::value ||
+          Has<Graph, SecondVisitor>::value>::type;
+
+      public:
+        /**
+         * @brief Constructor.
+         *
+         * @param first The first visitor.
+         * @param second The second visitor.
+         */
+        CompositeDFSVisitor(First first, Second second)
+          : m_first(std::forward<First>(first)),
+            m_second(std::forward<Second>(second))
+        {
+        }
+
+        /**
+         * @brief Get the first visitor.
+         */
+        FirstVisitor& first()
+        {
+          return m_first;
+        }
+
+        /**
+         * @brief Get the second visitor.
+         */
+        SecondVisitor& second()
+        {
+          return m_second;
+        }
+
+        /**
+         * @brief Forward the initialize event.
+         */
+        template<typename Graph>
+        auto initialize(const Graph &g)
+          -> EnableIfAny<impl::HasInitializeEvent, Graph>
+        {
+          impl::invokeInitialize(m_first, g);
+          impl::invokeInitialize(m_second, g);
+        }
+
+        /**
+         * @brief Forward the component event.
+         */
+        template<typename Graph>
+        auto component(const Graph &g, unsigned int i)
+          -> EnableIfAny<impl::HasComponentEvent, Graph>
+        {
+          impl::invokeComponent(m_first, g, i);
+          impl::invokeComponent(m_second, g, i);
+        }
+
+        /**
+         * @brief Forward the vertex event.
+         */
+        template<typename Graph>
+        auto vertex(const Graph &g, typename GraphTraits<Graph>::Vertex v)
+          -> EnableIfAny<impl::HasVertexEvent, Graph>
+        {
+          impl::invokeVertex(m_first, g, v);
+          impl::invokeVertex(m_second, g, v);
+        }
+
+        /**
+         * @brief Forward the edge event.
+         */
+        template<typename Graph>
+        auto edge(const Graph &g, typename GraphTraits<Graph>::Edge e)
+          -> EnableIfAny<impl::HasEdgeEvent, Graph>
+        {
+          impl::invokeEdge(m_first, g, e);
+          impl::invokeEdge(m_second, g, e);
+        }
+
+        /**
+         * @brief Forward the back edge event.
+         */
+        template<typename Graph>
+        auto backEdge(const Graph &g, typename GraphTraits<Graph>::Edge e)
+          -> EnableIfAny<impl::HasBackEdgeEvent, Graph>
+        {
+          impl::invokeBackEdge(m_first, g, e);
+          impl::invokeBackEdge(m_second, g, e);
+        }
 
-          dfs(g, w, visitor, visited);
+        /**
+         * @brief Forward the finish edge event.
+         */
+        template<typename Graph>
+        auto finishEdge(const Graph &g, typename GraphTraits<Graph>::Edge e)
+          -> EnableIfAny<impl::HasFinishEdgeEvent, Graph>
+        {
+          impl::invokeFinishEdge(m_first, g, e);
+          impl::invokeFinishEdge(m_second, g, e);
+        }
 
-          // invoke finish edge visitor
-          visitor.finishEdge(g, e);
+        /**
+         * @brief Forward the finish vertex event.
+         */
+        template<typename Graph>
+        auto finishVertex(const Graph &g, typename GraphTraits<Graph>::Vertex v)
+          -> EnableIfAny<impl::HasFinishVertexEvent, Graph>
+        {
+          impl::invokeFinishVertex(m_first, g, v);
+          impl::invokeFinishVertex(m_second, g, v);
         }
 
-        // invoke finish vertex visitor
-        visitor.finishVertex(g, v);
+      private:
+        First m_first;
+        Second m_second;
+    };
+
+    namespace impl {
+
+      template<typename ...Visitors>
+      struct CompositeDFSVisitorType;
+
+      template<typename Visitor>
+      struct CompositeDFSVisitorType<Visitor>
+      {
+        using Type = Visitor&;
+      };
+
+      template<typename First, typename ...Others>
+      struct CompositeDFSVisitorType<First, Others...>
+      {
+        using Type = CompositeDFSVisitor<First&,
+              typename CompositeDFSVisitorType<Others...>::Type>;
+      };
+
+      template<typename Visitor>
+      Visitor& combineDFSVisitors(Visitor &visitor)
+      {
+        return visitor;
+      }
+
+      template<typename First, typename Second, typename ...Others>
+      typename CompositeDFSVisitorType<First, Second, Others...>::Type
+      combineDFSVisitors(First &first, Second &second, Others&... others)
+      {
+        return typename CompositeDFSVisitorType<First, Second, Others...>::Type(
+            first, impl::combineDFSVisitors(second, others...));
       }
 
     } // namespace impl
 
+    /**
+     * @brief Combine DFS visitors to share a single DFS pass.
+     *
+     * The visitors are stored by reference and receive the events in the
+     * order they are given.
+     *
+     * @code
+     * MyRingVisitor rings;
+     * MyChainVisitor chains;
+     * auto visitor = combineDFSVisitors(rings, chains);
+     * dfs(g, visitor);
+     * @endcode
+     *
+     * @param first The first visitor.
+     * @param second The second visitor.
+     * @param others More visitors.
+     */
+    template<typename First, typename Second, typename ...Others>
+    typename impl::CompositeDFSVisitorType<First, Second, Others...>::Type
+    combineDFSVisitors(First &first, Second &second, Others&... others)
+    {
+      return impl::combineDFSVisitors(first, second, others...);
+    }
+
     /**
      * @brief Perform a depth-first search on a graph (DFS).
      *
@@ -186,7 +494,9 @@ namespace ocgl {
      *
      * This function makes use of a visitor functor to allow actions to be
      * performed. Visitors can be implemented by inheriting the DFSVisitor
-     * class and reimplementing the required functions.
+     * class and reimplementing the required functions. Only the implemented
+     * functions are invoked. Use combineDFSVisitors() to run several
+     * visitors in one search.
      *
      * @param g The graph.
      * @param visitor The DFS visitor.
@@ -197,18 +507,36 @@ namespace ocgl {
     template<typename Graph, typename DFSVisitor>
     void dfs(const Graph &g, DFSVisitor &visitor)
     {
-      visitor.initialize(g);
+      TraversalWorkspace<Graph> workspace;
+      dfs(g, visitor, workspace);
+    }
+
+    /**
+     * @brief Perform a depth-first search on a graph (DFS) using a workspace.
+     *
+     * Same as dfs(g, visitor) but the visited markers and the stack are
+     * reused from the workspace instead of allocated.
+     *
+     * @param g The graph.
+     * @param visitor The DFS visitor.
+     * @param workspace The workspace.
+     */
+    template<typename Graph, typename DFSVisitor>
+    void dfs(const Graph &g, DFSVisitor &visitor,
+        TraversalWorkspace<Graph> &workspace)
+    {
+      impl::invokeInitialize(visitor, g);
 
-      // keep track of visited vertices and edges using property maps
-      VertexEdgePropertyMap<Graph, bool> visited(g);
+      // keep track of visited vertices and edges using the workspace
+      workspace.start(g);
 
       unsigned int c = 0;
       for (auto v : getVertices(g)) {
-        if (!visited.vertices[v]) {
+        if (!workspace.isVertexVisited(v)) {
           // invoke component visitor
-          visitor.component(g, c++);
+          impl::invokeComponent(visitor, g, c++);
           // initiate DFS for component
-          impl::dfs(g, v, visitor, visited);
+          impl::dfs(g, v, visitor, workspace);
         }
       }
     }
@@ -223,7 +551,9 @@ namespace ocgl {
      *
      * This function makes use of a visitor functor to allow actions to be
      * performed. Visitors can be implemented by inheriting the DFSVisitor
-     * class and reimplementing the required functions.
+     * class and reimplementing the required functions. Only the implemented
+     * functions are invoked. Use combineDFSVisitors() to run several
+     * visitors in one search.
      *
      * @param g The graph.
      * @param v The start vertex.
@@ -233,13 +563,30 @@ namespace ocgl {
     void dfs(const Graph &g, typename GraphTraits<Graph>::Vertex v,
         DFSVisitor &visitor)
     {
-      visitor.initialize(g);
+      TraversalWorkspace<Graph> workspace;
+      dfs(g, v, visitor, workspace);
+    }
+
+    /**
+     * @brief Perform a depth-first search on a component (DFS) using a
+     *        workspace.
+     *
+     * @param g The graph.
+     * @param v The start vertex.
+     * @param visitor The DFS visitor.
+     * @param workspace The workspace.
+     */
+    template<typename Graph, typename DFSVisitor>
+    void dfs(const Graph &g, typename GraphTraits<Graph>::Vertex v,
+        DFSVisitor &visitor, TraversalWorkspace<Graph> &workspace)
+    {
+      impl::invokeInitialize(visitor, g);
 
-      // keep track of visited vertices and edges using property maps
-      VertexEdgePropertyMap<Graph, bool> visited(g);
+      // keep track of visited vertices and edges using the workspace
+      workspace.start(g);
 
       // initiate DFS for component
-      impl::dfs(g, v, visitor, visited);
+      impl::dfs(g, v, visitor, workspace);
     }
 
   } // namespace algorithm
@@ -1,9 +1,7 @@
 #ifndef OCGL_ALGORITHM_DIJKSTRA_H
 #define OCGL_ALGORITHM_DIJKSTRA_H
 
-#include <ocgl/Path.h>
-#include <ocgl/PropertyMap.h>
-#include <ocgl/Predicates.h>
+#include <ocgl/algorithm/ShortestPathTree.h>
 
 #include <algorithm>
 #include <vector>
@@ -20,22 +18,106 @@ namespace ocgl {
 
     namespace impl {
 
-      template<typename Graph>
-      struct DijkstraHeapCompare
+      /**
+       * @brief Binary min-heap of indices with decrease-key support.
+       *
+       * The keys are stored externally (e.g. the distances in Dijkstra's
+       * algorithm). The position of each index in the heap is tracked so the
+       * heap can be restored in O(log n) time when a key is decreased.
+       */
+      class IndexedMinHeap
       {
-        using Vertex = typename GraphTraits<Graph>::Vertex;
+        public:
+          IndexedMinHeap(const std::vector<unsigned int> &keys)
+            : m_keys(keys), m_pos(keys.size(), npos())
+          {
+          }
 
-        DijkstraHeapCompare(const VertexPropertyMap<Graph, unsigned int> &dist_)
-          : dist(dist_)
-        {
-        }
+          static constexpr Index npos()
+          {
+            return std::numeric_limits<Index>::max();
+          }
 
-        bool operator()(Vertex u, Vertex v) const
-        {
-          return dist[u] >= dist[v];
-        }
+          bool empty() const
+          {
+            return m_heap.empty();
+          }
+
+          bool contains(Index i) const
+          {
+            return m_pos[i] != npos();
+          }
+
+          void push(Index i)
+          {
+            m_pos[i] = m_heap.size();
+            m_heap.push_back(i);
+            siftUp(m_heap.size() - 1);
+          }
+
+          Index pop()
+          {
+            Index top = m_heap.front();
+            m_pos[top] = npos();
+
+            Index last = m_heap.back();
+            m_heap.pop_back();
+            if (!m_heap.empty()) {
+              m_heap.front() = last;
+              m_pos[last] = 0;
+              siftDown(0);
+            }
+
+            return top;
+          }
+
+          /**
+           * @brief Restore the heap after the key for i has been decreased.
+           */
+          void decrease(Index i)
+          {
+            siftUp(m_pos[i]);
+          }
+
+        private:
+          void siftUp(std::size_t k)
+          {
+            Index i = m_heap[k];
+            while (k) {
+              std::size_t parent = (k - 1) / 2;
+              if (m_keys[m_heap[parent]] <= m_keys[i])
+                break;
+              m_heap[k] = m_heap[parent];
+              m_pos[m_heap[k]] = k;
+              k = parent;
+            }
+            m_heap[k] = i;
+            m_pos[i] = k;
+          }
+
+          void siftDown(std::size_t k)
+          {
+            Index i = m_heap[k];
+            while (true) {
+              std::size_t child = 2 * k + 1;
+              if (child >= m_heap.size())
+                break;
+              if (child + 1 < m_heap.size() &&
+                  m_keys[m_heap[child + 1]] < m_keys[m_heap[child]])
+                ++child;
+              if (m_keys[i] <= m_keys[m_heap[child]])
+                break;
+              m_heap[k] = m_heap[child];
+              m_pos[m_heap[k]] = k;
+              k = child;
+            }
+            m_heap[k] = i;
+            m_pos[i] = k;
+          }
 
-        const VertexPropertyMap<Graph, unsigned int> &dist;
+          const std::vector<unsigned int> &m_keys;
+          std::vector<Index> m_heap;
+          std::vector<Index> m_pos;
       };
 
     } // namespace impl
@@ -47,9 +129,14 @@ namespace ocgl {
      * vertex to all other vertices in a graph. The algorithm is executed when
      * the constructor is executed. Later, the distances and paths can be
      * retrieved using the distance() and path() member functions.
+     *
+     * An edge weight property map can be specified, without one all edges
+     * have weight 1. The vertices are kept in an indexed binary heap so the
+     * running time is O((V + E) log V). For unit edge weights, the
+     * BFSShortestPaths class gives the same distances in O(V + E) time.
      */
     template<typename Graph>
-    class Dijkstra
+    class Dijkstra : public ShortestPathTree<Graph>
     {
       public:
         /**
@@ -60,178 +147,118 @@ namespace ocgl {
         /**
          * @brief Constructor.
          *
-         * Using this constructor, all vertices will be considered.
+         * Using this constructor, all vertices will be considered and all
+         * edges have weight 1.
          *
          * @param g The graph.
          * @param source The source vertex.
          */
         Dijkstra(const Graph &g, Vertex source)
-          : m_graph(g), m_source(source), m_dist(g, infinity()),
-            m_prev(g, nullVertex<Graph>())
+          : ShortestPathTree<Graph>(g, source)
         {
-          // add all vertices in graph to Q
-          std::vector<Vertex> Q = getVertices(g).toVector();
-
-          VertexPropertyMap<Graph, bool> vertexMask(g, true);
-          dijkstra(Q, vertexMask);
+          dijkstra(static_cast<const VertexPropertyMap<Graph, bool>*>(nullptr),
+              static_cast<const EdgePropertyMap<Graph, unsigned int>*>(nullptr));
         }
 
         /**
          * @brief Constructor.
          *
          * Using this constructor, only the vertices in the mask will be
-         * considered.
+         * considered and all edges have weight 1.
          *
          * @param g The graph.
          * @param source The source vertex.
          * @param vertexMask The vertex mask.
+         *
+         * @pre vertexMask[source]
          */
         Dijkstra(const Graph &g, Vertex source,
             const VertexPropertyMap<Graph, bool> &vertexMask)
-          : m_graph(g), m_source(source), m_dist(g, infinity()),
-            m_prev(g, nullVertex<Graph>())
-        {
-          // add all vertices in graph to Q
-          std::vector<Vertex> Q = getVertices(g,
-              HasPropertyEQ(vertexMask, true)).toVector();
-
-          dijkstra(Q, vertexMask);
-        }
-
-        /**
-         * @brief Get the source vertex.
-         */
-        Vertex source() const
-        {
-          return m_source;
-        }
-
-        /**
-         * @brief Get the infinity value that is returned by distance().
-         *
-         * @return The infinity value.
-         */
-        unsigned int infinity() const
-        {
-          return std::numeric_limits<unsigned int>::max();
-        }
-
-        /**
-         * @brief Get the distance between source and target vertices.
-         *
-         * The distance is the number of bonds between the source and target
-         * vertices. If there is no path, the infinity() value is returned.
-         *
-         * @param target the target vertex.
-         */
-        unsigned int distance(Vertex target) const
+          : ShortestPathTree<Graph>(g, source)
         {
-          return m_dist[target];
+          dijkstra(&vertexMask,
+              static_cast<const EdgePropertyMap<Graph, unsigned int>*>(nullptr));
         }
 
         /**
-         * @brief Reconstruct the path between source and target vertices.
+         * @brief Constructor.
          *
-         * The path includes the source and target vertices
-         * (i.e. [source, ..., target]).
+         * Using this constructor, all vertices will be considered.
          *
-         * @param target the target vertex.
+         * @param g The graph.
+         * @param source The source vertex.
+         * @param weights The edge weights.
          */
-        VertexPath<Graph> path(Vertex target) const
+        Dijkstra(const Graph &g, Vertex source,
+            const EdgePropertyMap<Graph, unsigned int> &weights)
+          : ShortestPathTree<Graph>(g, source)
         {
-          VertexPath<Graph> S;
-          S.reserve(distance(target) + 1);
-          Vertex u = target;
-
-          // reconstruct the path
-          while (isValidVertex(m_graph, m_prev[u])) {
-            S.insert(S.begin(), u);
-            u = m_prev[u];
-          }
-
-          S.insert(S.begin(), m_source);
-
-          return S;
+          dijkstra(static_cast<const VertexPropertyMap<Graph, bool>*>(nullptr),
+              &weights);
         }
 
         /**
-         * @brief Reconstruct the reverse path between target and source vertices.
+         * @brief Constructor.
          *
-         * The path includes the source and target vertices
-         * (i.e. [target, ..., source]).
+         * Using this constructor, only the vertices in the mask will be
+         * considered.
          *
-         * @param target the target vertex.
-         */
-        VertexPath<Graph> reversePath(Vertex target) const
-        {
-          VertexPath<Graph> S;
-          S.reserve(distance(target) + 1);
-          Vertex u = target;
-
-          // reconstruct the path
-          while (isValidVertex(m_graph, m_prev[u])) {
-            S.push_back(u);
-            u = m_prev[u];
-          }
-
-          S.push_back(m_source);
-
-          return S;
-        }
-
-        /**
-         * @brief Get the map with previous vertices.
+         * @param g The graph.
+         * @param source The source vertex.
+         * @param vertexMask The vertex mask.
+         * @param weights The edge weights.
          *
-         * This map gives, for each vertex, the previous vertex for the shortest
-         * path to source.
+         * @pre vertexMask[source]
          */
-        const VertexPropertyMap<Graph, Vertex>& prev() const
+        Dijkstra(const Graph &g, Vertex source,
+            const VertexPropertyMap<Graph, bool> &vertexMask,
+            const EdgePropertyMap<Graph, unsigned int> &weights)
+          : ShortestPathTree<Graph>(g, source)
         {
-          return m_prev;
+          dijkstra(&vertexMask, &weights);
         }
 
       private:
-        void dijkstra(std::vector<Vertex> &Q,
-            const VertexPropertyMap<Graph, bool> &vertexMask)
+        void dijkstra(const VertexPropertyMap<Graph, bool> *vertexMask,
+            const EdgePropertyMap<Graph, unsigned int> *weights)
         {
+          const Graph &g = this->m_graph;
+          auto &dist = this->m_dist;
+          auto &prev = this->m_prev;
+
           // distance from source to source
-          m_dist[m_source] = 0;
+          dist[this->m_source] = 0;
 
-          // make Q a heap [heap implementation only]
-          using HeapCompare = typename impl::DijkstraHeapCompare<Graph>;
-          std::make_heap(Q.begin(), Q.end(), HeapCompare(m_dist));
+          // only reached vertices are added to Q
+          impl::IndexedMinHeap Q(dist.map());
+          Q.push(getVertexIndex(g, this->m_source));
 
-          while (Q.size()) {
-            // find vertex in Q with smallest distance in m_dist
-            Vertex u = Q.front();
-            // remove u from Q
-            std::pop_heap(Q.begin(), Q.end(), HeapCompare(m_dist));
-            Q.pop_back();
+          while (!Q.empty()) {
+            // remove vertex with smallest distance from Q
+            Vertex u = getVertex(g, Q.pop());
 
-            if (m_dist[u] == infinity())
-              // all remaining vertices are inaccessible from source
-              break;
+            for (auto e : getIncident(g, u)) {
+              auto v = getOther(g, e, u);
 
-            for (auto v : getAdjacent(m_graph, u)) {
-              if (!vertexMask[v])
+              if (vertexMask && !(*vertexMask)[v])
                 continue;
 
-              unsigned int alt = m_dist[u] + 1;
+              unsigned int alt = dist[u] + (weights ? (*weights)[e] : 1);
+
+              if (alt < dist[v]) {
+                bool reached = dist[v] != this->infinity();
+                dist[v] = alt;
+                prev[v] = u;
 
-              if (alt < m_dist[v]) {
-                m_dist[v] = alt;
-                m_prev[v] = u;
-                std::make_heap(Q.begin(), Q.end(), HeapCompare(m_dist));
+                auto vi = getVertexIndex(g, v);
+                if (!reached)
+                  Q.push(vi);
+                else if (Q.contains(vi))
+                  Q.decrease(vi);
               }
             }
-
           }
         }
-
-        const Graph &m_graph;
-        Vertex m_source;
-        VertexPropertyMap<Graph, unsigned int> m_dist;
-        VertexPropertyMap<Graph, Vertex> m_prev;
     };
 
   } // namespace algorithm
@@ -3,6 +3,16 @@
 
 #include <ocgl/algorithm/VF2State.h>
 #include <ocgl/algorithm/Backtrack.h>
+#include <ocgl/algorithm/SubgraphScreen.h>
+#include <ocgl/Parallel.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 namespace ocgl {
 
@@ -10,24 +20,1304 @@ namespace ocgl {
 
     namespace impl {
 
-      template<typename Query, typename Graph>
-      void isomorphisms(const Query &query, const Graph &graph, std::function<bool(const VertexPropertyMap<Query, typename GraphTraits<Graph>::Vertex>&)> visitor)
+      /**
+       * @brief Tag for searches without target vertex labels (the label
+       *        histogram test is skipped).
+       */
+      struct NoVertexLabel
+      {
+      };
+
+      template<typename Graph>
+      void computeTargetLabels(SubgraphInvariants&, const Graph&, NoVertexLabel)
+      {
+      }
+
+      template<typename Graph, typename TargetLabel>
+      void computeTargetLabels(SubgraphInvariants &invariants,
+          const Graph &target, TargetLabel targetLabel)
+      {
+        invariants.computeLabels(target, targetLabel);
+      }
+
+      /**
+       * @brief Run the screen's tests that do not need the target's cycles.
+       *
+       * The target's label histogram is only computed if the query has one
+       * and the label test is enabled.
+       */
+      template<typename Graph, typename TargetLabel>
+      bool screenTargetCheap(const SubgraphInvariants &query,
+          const Graph &target, SubgraphScreen &screen, TargetLabel targetLabel,
+          SubgraphInvariants &invariants)
+      {
+        invariants.compute(target);
+        if (query.hasLabels() &&
+            screen.isEnabled(SubgraphScreen::LabelHistogram))
+          computeTargetLabels(invariants, target, targetLabel);
+
+        return screen.mayContain(invariants, query);
+      }
+
+      /**
+       * @brief Run the screen's cycle test, the target's cycle counts are
+       *        only computed (DFS) if the query has cycles.
+       */
+      template<typename Graph>
+      bool screenTargetCycles(const SubgraphInvariants &query,
+          const Graph &target, SubgraphScreen &screen,
+          SubgraphInvariants &invariants)
+      {
+        if (!query.numCyclicEdges())
+          return true;
+
+        invariants.computeCycles(target);
+        return screen.mayContainCycles(invariants, query);
+      }
+
+      /**
+       * @brief Screen a target using query invariants.
+       *
+       * Each test is run once, the cycle test only if the cheap tests pass.
+       * The query's cycle counts must be computed to run the cycle test.
+       *
+       * @param invariants Set to the target's invariants.
+       *
+       * @return False if the target can not contain the query.
+       */
+      template<typename Graph, typename TargetLabel>
+      bool screenTarget(const SubgraphInvariants &query, const Graph &target,
+          SubgraphScreen &screen, TargetLabel targetLabel,
+          SubgraphInvariants &invariants)
+      {
+        if (!screenTargetCheap(query, target, screen, targetLabel, invariants))
+          return false;
+
+        return !screen.isEnabled(SubgraphScreen::CycleCount) ||
+          screenTargetCycles(query, target, screen, invariants);
+      }
+
+      /**
+       * @brief Screen a target using the query invariants of a plan.
+       *
+       * If the plan has no cycle counts (see MatchPlan::computeCycles()),
+       * they are computed here, but only if the cheap tests pass.
+       */
+      template<typename Query, typename Graph, typename TargetLabel>
+      bool screenTarget(const MatchPlan<Query> &plan, const Graph &target,
+          SubgraphScreen &screen, TargetLabel targetLabel,
+          SubgraphInvariants &invariants)
+      {
+        const SubgraphInvariants &query = plan.invariants();
+        if (!screenTargetCheap(query, target, screen, targetLabel, invariants))
+          return false;
+
+        if (!screen.isEnabled(SubgraphScreen::CycleCount))
+          return true;
+        if (query.hasCycles())
+          return screenTargetCycles(query, target, screen, invariants);
+
+        SubgraphInvariants cyclicQuery(plan.query());
+        cyclicQuery.computeCycles(plan.query());
+        return screenTargetCycles(cyclicQuery, target, screen, invariants);
+      }
+
+      /**
+       * @brief Get the query invariants to screen many targets.
+       *
+       * The cycle counts are computed once if the plan has none and the
+       * screen's cycle test is enabled.
+       */
+      template<typename Query>
+      SubgraphInvariants screenInvariants(const MatchPlan<Query> &plan,
+          const SubgraphScreen &screen)
+      {
+        SubgraphInvariants query = plan.invariants();
+        if (!query.hasCycles() && screen.isEnabled(SubgraphScreen::CycleCount))
+          query.computeCycles(plan.query());
+        return query;
+      }
+
+      template<typename Query, typename Graph, typename GoalVisitor,
+               typename TargetLabel, typename VertexMatcher,
+               typename EdgeMatcher>
+      void searchIsomorphisms(const MatchPlan<Query> &plan, const Graph &graph,
+          GoalVisitor &visitor, SubgraphScreen &screen, TargetLabel targetLabel,
+          VertexMatcher vertexMatcher, EdgeMatcher edgeMatcher)
+      {
+        // the invariants are cheaper than building the state
+        SubgraphInvariants invariants;
+        if (!screenTarget(plan, graph, screen, targetLabel, invariants))
+          return;
+
+        impl::VF2State<Query, Graph, VertexMatcher, EdgeMatcher> state(plan,
+            graph, vertexMatcher, edgeMatcher);
+        backtrackGoals(state, visitor);
+      }
+
+      template<typename Query, typename Graph, typename Visitor,
+               typename TargetLabel, typename VertexMatcher,
+               typename EdgeMatcher>
+      void isomorphisms(const MatchPlan<Query> &plan, const Graph &graph,
+          Visitor &visitor, SubgraphScreen &screen, TargetLabel targetLabel,
+          VertexMatcher vertexMatcher, EdgeMatcher edgeMatcher)
+      {
+        auto goalVisitor = [&visitor] (const VF2State<Query, Graph,
+            VertexMatcher, EdgeMatcher> &state) {
+          return visitor(state.solution());
+        };
+        searchIsomorphisms(plan, graph, goalVisitor, screen, targetLabel,
+            vertexMatcher, edgeMatcher);
+      }
+
+      template<typename Query, typename Graph, typename Visitor,
+               typename TargetLabel, typename VertexMatcher,
+               typename EdgeMatcher>
+      void isomorphismMappings(const MatchPlan<Query> &plan, const Graph &graph,
+          Visitor &visitor, SubgraphScreen &screen, TargetLabel targetLabel,
+          VertexMatcher vertexMatcher, EdgeMatcher edgeMatcher)
+      {
+        auto goalVisitor = [&visitor] (const VF2State<Query, Graph,
+            VertexMatcher, EdgeMatcher> &state) {
+          return visitor(state.mapping());
+        };
+        searchIsomorphisms(plan, graph, goalVisitor, screen, targetLabel,
+            vertexMatcher, edgeMatcher);
+      }
+
+      template<typename Query, typename Graph, typename TargetLabel,
+               typename VertexMatcher, typename EdgeMatcher>
+      std::size_t countIsomorphisms(const MatchPlan<Query> &plan,
+          const Graph &graph, SubgraphScreen &screen, TargetLabel targetLabel,
+          VertexMatcher vertexMatcher, EdgeMatcher edgeMatcher)
+      {
+        std::size_t count = 0;
+        auto goalVisitor = [&count] (const VF2State<Query, Graph,
+            VertexMatcher, EdgeMatcher>&) {
+          ++count;
+          return false;
+        };
+        searchIsomorphisms(plan, graph, goalVisitor, screen, targetLabel,
+            vertexMatcher, edgeMatcher);
+        return count;
+      }
+
+      template<typename Query, typename Graph, typename TargetLabel,
+               typename VertexMatcher, typename EdgeMatcher>
+      bool hasIsomorphism(const MatchPlan<Query> &plan, const Graph &graph,
+          SubgraphScreen &screen, TargetLabel targetLabel,
+          VertexMatcher vertexMatcher, EdgeMatcher edgeMatcher)
+      {
+        bool found = false;
+        auto goalVisitor = [&found] (const VF2State<Query, Graph,
+            VertexMatcher, EdgeMatcher>&) {
+          found = true;
+          return true;
+        };
+        searchIsomorphisms(plan, graph, goalVisitor, screen, targetLabel,
+            vertexMatcher, edgeMatcher);
+        return found;
+      }
+
+      /**
+       * @brief Search the subgraph isomorphisms using multiple threads.
+       *
+       * The graph is screened once before any thread is started. Each
+       * candidate graph vertex for the first query vertex of the plan is
+       * a work item. A work item maps the first query vertex to the graph
+       * vertex and searches the resulting subtree using the thread's own
+       * VF2State. The work items are distributed using parallelFor(), so
+       * idle threads steal subtrees from busy threads. When the visitor
+       * returns true, the searches in all threads are stopped.
+       *
+       * The visitor is called as visitor(state, thread) and must be thread
+       * safe. The matchers are copied for each thread and are called
+       * concurrently.
+       */
+      template<typename Query, typename Graph, typename GoalVisitor,
+               typename VertexMatcher, typename EdgeMatcher>
+      void searchIsomorphismsParallel(const MatchPlan<Query> &plan,
+          const Graph &graph, GoalVisitor &visitor, SubgraphScreen &screen,
+          unsigned int numThreads, VertexMatcher vertexMatcher,
+          EdgeMatcher edgeMatcher)
+      {
+        using State = VF2State<Query, Graph, VertexMatcher, EdgeMatcher>;
+
+        SubgraphInvariants invariants;
+        if (!screenTarget(plan, graph, screen, NoVertexLabel(), invariants))
+          return;
+
+        // no first pairs to divide
+        if (!plan.size() || !numVertices(graph)) {
+          auto serialVisitor = [&visitor] (const State &state) {
+            return visitor(state, 0u);
+          };
+          State state(plan, graph, vertexMatcher, edgeMatcher);
+          backtrackGoals(state, serialVisitor);
+          return;
+        }
+
+        if (!numThreads)
+          numThreads = hardwareThreads();
+
+        std::vector<std::unique_ptr<State>> states(numThreads);
+        std::atomic<bool> stop(false);
+        auto u = plan.vertex(0);
+
+        parallelFor(numVertices(graph), numThreads,
+            [&] (std::size_t item, unsigned int thread) {
+          if (stop.load(std::memory_order_relaxed))
+            return;
+
+          auto &state = states[thread];
+          if (!state)
+            state.reset(new State(plan, graph, vertexMatcher, edgeMatcher));
+
+          auto v = getVertex(graph, item);
+          if (!state->isFeasiblePair(u, v))
+            return;
+
+          state->addPair(u, v);
+
+          BacktrackSearch<State> search(*state);
+          search.setStopFlag(&stop);
+          while (search.next())
+            if (visitor(static_cast<const State&>(*state), thread)) {
+              stop = true;
+              search.stop();
+            }
+
+          state->removePair(u, v);
+        });
+      }
+
+      /**
+       * @brief Per thread counter (padded to avoid false sharing).
+       */
+      struct ThreadCount
+      {
+        std::size_t value;
+        char padding[64 - sizeof(std::size_t)];
+      };
+
+      template<typename Query, typename Graph,
+               typename VertexMatcher, typename EdgeMatcher>
+      std::size_t countIsomorphismsParallel(const MatchPlan<Query> &plan,
+          const Graph &graph, SubgraphScreen &screen, unsigned int numThreads,
+          VertexMatcher vertexMatcher, EdgeMatcher edgeMatcher)
+      {
+        if (!numThreads)
+          numThreads = hardwareThreads();
+
+        std::vector<ThreadCount> counts(numThreads, ThreadCount{0, {}});
+        auto goalVisitor = [&counts] (const VF2State<Query, Graph,
+            VertexMatcher, EdgeMatcher>&, unsigned int thread) {
+          ++counts[thread].value;
+          return false;
+        };
+        searchIsomorphismsParallel(plan, graph, goalVisitor, screen,
+            numThreads, vertexMatcher, edgeMatcher);
+
+        std::size_t count = 0;
+        for (const auto &threadCount : counts)
+          count += threadCount.value;
+        return count;
+      }
+
+      template<typename Query, typename Graph,
+               typename VertexMatcher, typename EdgeMatcher>
+      bool hasIsomorphismParallel(const MatchPlan<Query> &plan,
+          const Graph &graph, SubgraphScreen &screen, unsigned int numThreads,
+          VertexMatcher vertexMatcher, EdgeMatcher edgeMatcher)
       {
-        impl::VF2State<Query, Graph> state(query, graph);
-        backtrack(state, visitor);
+        std::atomic<bool> found(false);
+        auto goalVisitor = [&found] (const VF2State<Query, Graph,
+            VertexMatcher, EdgeMatcher>&, unsigned int) {
+          found = true;
+          return true;
+        };
+        searchIsomorphismsParallel(plan, graph, goalVisitor, screen,
+            numThreads, vertexMatcher, edgeMatcher);
+        return found;
+      }
+
+      /**
+       * @brief Get the graph type of a range of target graphs.
+       */
+      template<typename Targets>
+      using TargetGraph = typename std::decay<decltype(
+          std::declval<const Targets&>()[0])>::type;
+
+      /**
+       * @brief Search a query in many target graphs using multiple threads.
+       *
+       * Each target is a work item. The targets are distributed using
+       * parallelFor(), so idle threads steal targets from busy threads. Every
+       * thread has its own VF2State that is reused for all of its targets.
+       * The state's buffers are sized to the largest target once.
+       *
+       * Targets rejected by the screen are skipped, every thread screens its
+       * targets with its own copy of the screen and the counters are added
+       * to screen when all targets are done. The query's invariants (see
+       * screenInvariants()) are computed once for all targets. The cycle
+       * counts are only computed for the targets if the query has cycles and
+       * the label histograms if the query has labels (see screenTarget()).
+       * For the other targets, visitor(state, target, thread) is called with
+       * the state for the target and has to run the search.
+       */
+      template<typename Query, typename Targets, typename TargetVisitor,
+               typename TargetLabel, typename VertexMatcher,
+               typename EdgeMatcher>
+      void searchBatch(const MatchPlan<Query> &plan, const Targets &targets,
+          TargetVisitor &visitor, SubgraphScreen &screen,
+          TargetLabel targetLabel, unsigned int numThreads,
+          VertexMatcher vertexMatcher, EdgeMatcher edgeMatcher)
+      {
+        using Graph = TargetGraph<Targets>;
+        using State = VF2State<Query, Graph, VertexMatcher, EdgeMatcher>;
+
+        if (!numThreads)
+          numThreads = hardwareThreads();
+
+        unsigned int maxVertices = 0;
+        for (std::size_t i = 0; i < targets.size(); ++i)
+          maxVertices = std::max(maxVertices, numVertices(targets[i]));
+
+        auto queryInvariants = screenInvariants(plan, screen);
+        std::vector<std::unique_ptr<State>> states(numThreads);
+        std::vector<SubgraphInvariants> targetInvariants(numThreads);
+        std::vector<SubgraphScreen> screens(numThreads, screen);
+        for (auto &threadScreen : screens)
+          threadScreen.resetCounters();
+
+        parallelFor(targets.size(), numThreads,
+            [&] (std::size_t i, unsigned int thread) {
+          const Graph &target = targets[i];
+          if (!screenTarget(queryInvariants, target, screens[thread],
+                targetLabel, targetInvariants[thread]))
+            return;
+
+          auto &state = states[thread];
+          if (!state) {
+            state.reset(new State(plan, target, vertexMatcher, edgeMatcher));
+            state->reserve(maxVertices);
+          } else
+            state->setGraph(target);
+
+          visitor(*state, i);
+        });
+
+        for (const auto &threadScreen : screens)
+          screen.mergeCounters(threadScreen);
       }
 
     } // namespace impl
 
-    template<typename Query, typename Graph, typename Visitor>
-    void isomorphisms(const Query &query, const Graph &graph, Visitor visitor)
+    /**
+     * @brief Find the subgraph isomorphisms (monomorphisms) of query in graph.
+     *
+     * The visitor is called for each isomorphism with a
+     * VertexPropertyMap<Query, GraphVertex> and returns true to stop.
+     *
+     * The matchers are called as vertexMatcher(queryVertex, graphVertex) and
+     * edgeMatcher(queryEdge, graphEdge) and return true if the pair can be
+     * mapped. All types are template parameters, so the calls are inlined.
+     * The default impl::AlwaysMatch matchers are removed by the compiler.
+     */
+    template<typename Query, typename Graph, typename Visitor,
+             typename VertexMatcher = impl::AlwaysMatch,
+             typename EdgeMatcher = impl::AlwaysMatch>
+    void isomorphisms(const Query &query, const Graph &graph, Visitor visitor,
+        VertexMatcher vertexMatcher = VertexMatcher(),
+        EdgeMatcher edgeMatcher = EdgeMatcher())
+    {
+      MatchPlan<Query> plan(query);
+      SubgraphScreen screen;
+      impl::isomorphisms(plan, graph, visitor, screen,
+          impl::NoVertexLabel(), vertexMatcher, edgeMatcher);
+    }
+
+    /**
+     * @brief Find the subgraph isomorphisms of a query using a precomputed
+     *        MatchPlan.
+     *
+     * The same plan can be used for many graphs.
+     */
+    template<typename Query, typename Graph, typename Visitor,
+             typename VertexMatcher = impl::AlwaysMatch,
+             typename EdgeMatcher = impl::AlwaysMatch>
+    void isomorphisms(const MatchPlan<Query> &plan, const Graph &graph,
+        Visitor visitor, VertexMatcher vertexMatcher = VertexMatcher(),
+        EdgeMatcher edgeMatcher = EdgeMatcher())
+    {
+      SubgraphScreen screen;
+      impl::isomorphisms(plan, graph, visitor, screen,
+          impl::NoVertexLabel(), vertexMatcher, edgeMatcher);
+    }
+
+    /**
+     * @brief Find the subgraph isomorphisms of a query using a precomputed
+     *        MatchPlan and a screen.
+     *
+     * The graph is only searched if it passes the screen. Using the same
+     * screen for many graphs counts how often each test rejected a graph
+     * (see SubgraphScreen::numRejected()).
+     */
+    template<typename Query, typename Graph, typename Visitor,
+             typename VertexMatcher = impl::AlwaysMatch,
+             typename EdgeMatcher = impl::AlwaysMatch>
+    void isomorphisms(const MatchPlan<Query> &plan, const Graph &graph,
+        Visitor visitor, SubgraphScreen &screen,
+        VertexMatcher vertexMatcher = VertexMatcher(),
+        EdgeMatcher edgeMatcher = EdgeMatcher())
+    {
+      impl::isomorphisms(plan, graph, visitor, screen,
+          impl::NoVertexLabel(), vertexMatcher, edgeMatcher);
+    }
+
+    /**
+     * @brief Find the subgraph isomorphisms of a query using a precomputed
+     *        MatchPlan, a screen and vertex labels.
+     *
+     * If the plan has a label histogram (see MatchPlan::computeLabels()),
+     * the graph's label histogram is computed using targetLabel(vertex) and
+     * the screen's LabelHistogram test is run.
+     */
+    template<typename Query, typename Graph, typename Visitor,
+             typename TargetLabel,
+             typename VertexMatcher = impl::AlwaysMatch,
+             typename EdgeMatcher = impl::AlwaysMatch>
+    void isomorphisms(const MatchPlan<Query> &plan, const Graph &graph,
+        Visitor visitor, TargetLabel targetLabel, SubgraphScreen &screen,
+        VertexMatcher vertexMatcher = VertexMatcher(),
+        EdgeMatcher edgeMatcher = EdgeMatcher())
+    {
+      impl::isomorphisms(plan, graph, visitor, screen, targetLabel,
+          vertexMatcher, edgeMatcher);
+    }
+
+    /**
+     * @brief Find the subgraph isomorphisms of query in graph without
+     *        allocating a property map for each isomorphism.
+     *
+     * The visitor is called with a MappingView<Query, Graph> that is only
+     * valid during the call and returns true to stop.
+     */
+    template<typename Query, typename Graph, typename Visitor,
+             typename VertexMatcher = impl::AlwaysMatch,
+             typename EdgeMatcher = impl::AlwaysMatch>
+    void isomorphismMappings(const Query &query, const Graph &graph,
+        Visitor visitor, VertexMatcher vertexMatcher = VertexMatcher(),
+        EdgeMatcher edgeMatcher = EdgeMatcher())
+    {
+      MatchPlan<Query> plan(query);
+      SubgraphScreen screen;
+      impl::isomorphismMappings(plan, graph, visitor, screen,
+          impl::NoVertexLabel(), vertexMatcher, edgeMatcher);
+    }
+
+    /**
+     * @brief Find the subgraph isomorphisms of a query using a precomputed
+     *        MatchPlan without allocating a property map for each isomorphism.
+     */
+    template<typename Query, typename Graph, typename Visitor,
+             typename VertexMatcher = impl::AlwaysMatch,
+             typename EdgeMatcher = impl::AlwaysMatch>
+    void isomorphismMappings(const MatchPlan<Query> &plan, const Graph &graph,
+        Visitor visitor, VertexMatcher vertexMatcher = VertexMatcher(),
+        EdgeMatcher edgeMatcher = EdgeMatcher())
+    {
+      SubgraphScreen screen;
+      impl::isomorphismMappings(plan, graph, visitor, screen,
+          impl::NoVertexLabel(), vertexMatcher, edgeMatcher);
+    }
+
+    /**
+     * @brief Find the subgraph isomorphisms of a query using a precomputed
+     *        MatchPlan and a screen without allocating a property map for
+     *        each isomorphism.
+     */
+    template<typename Query, typename Graph, typename Visitor,
+             typename VertexMatcher = impl::AlwaysMatch,
+             typename EdgeMatcher = impl::AlwaysMatch>
+    void isomorphismMappings(const MatchPlan<Query> &plan, const Graph &graph,
+        Visitor visitor, SubgraphScreen &screen,
+        VertexMatcher vertexMatcher = VertexMatcher(),
+        EdgeMatcher edgeMatcher = EdgeMatcher())
+    {
+      impl::isomorphismMappings(plan, graph, visitor, screen,
+          impl::NoVertexLabel(), vertexMatcher, edgeMatcher);
+    }
+
+    /**
+     * @brief Find the subgraph isomorphisms of a query using a precomputed
+     *        MatchPlan, a screen and vertex labels without allocating a
+     *        property map for each isomorphism.
+     */
+    template<typename Query, typename Graph, typename Visitor,
+             typename TargetLabel,
+             typename VertexMatcher = impl::AlwaysMatch,
+             typename EdgeMatcher = impl::AlwaysMatch>
+    void isomorphismMappings(const MatchPlan<Query> &plan, const Graph &graph,
+        Visitor visitor, TargetLabel targetLabel, SubgraphScreen &screen,
+        VertexMatcher vertexMatcher = VertexMatcher(),
+        EdgeMatcher edgeMatcher = EdgeMatcher())
+    {
+      impl::isomorphismMappings(plan, graph, visitor, screen, targetLabel,
+          vertexMatcher, edgeMatcher);
+    }
+
+    /**
+     * @brief Count the subgraph isomorphisms of query in graph.
+     *
+     * The mappings are never materialized.
+     */
+    template<typename Query, typename Graph,
+             typename VertexMatcher = impl::AlwaysMatch,
+             typename EdgeMatcher = impl::AlwaysMatch>
+    std::size_t countIsomorphisms(const Query &query, const Graph &graph,
+        VertexMatcher vertexMatcher = VertexMatcher(),
+        EdgeMatcher edgeMatcher = EdgeMatcher())
+    {
+      MatchPlan<Query> plan(query);
+      SubgraphScreen screen;
+      return impl::countIsomorphisms(plan, graph, screen,
+          impl::NoVertexLabel(), vertexMatcher, edgeMatcher);
+    }
+
+    /**
+     * @brief Count the subgraph isomorphisms of a query using a precomputed
+     *        MatchPlan.
+     */
+    template<typename Query, typename Graph,
+             typename VertexMatcher = impl::AlwaysMatch,
+             typename EdgeMatcher = impl::AlwaysMatch>
+    std::size_t countIsomorphisms(const MatchPlan<Query> &plan,
+        const Graph &graph, VertexMatcher vertexMatcher = VertexMatcher(),
+        EdgeMatcher edgeMatcher = EdgeMatcher())
+    {
+      SubgraphScreen screen;
+      return impl::countIsomorphisms(plan, graph, screen,
+          impl::NoVertexLabel(), vertexMatcher, edgeMatcher);
+    }
+
+    /**
+     * @brief Count the subgraph isomorphisms of a query using a precomputed
+     *        MatchPlan and a screen.
+     */
+    template<typename Query, typename Graph,
+             typename VertexMatcher = impl::AlwaysMatch,
+             typename EdgeMatcher = impl::AlwaysMatch>
+    std::size_t countIsomorphisms(const MatchPlan<Query> &plan,
+        const Graph &graph, SubgraphScreen &screen,
+        VertexMatcher vertexMatcher = VertexMatcher(),
+        EdgeMatcher edgeMatcher = EdgeMatcher())
+    {
+      return impl::countIsomorphisms(plan, graph, screen,
+          impl::NoVertexLabel(), vertexMatcher, edgeMatcher);
+    }
+
+    /**
+     * @brief Count the subgraph isomorphisms of a query using a precomputed
+     *        MatchPlan, a screen and vertex labels.
+     *
+     * @code
+     * MatchPlan<Query> plan(query);
+     * plan.computeLabels([&] (QueryVertex u) { return queryElement[u]; });
+     * auto targetLabel = [&] (GraphVertex v) { return element[v]; };
+     * SubgraphScreen screen;
+     * auto n = countIsomorphisms(plan, graph, targetLabel, screen, matcher);
+     * @endcode
+     */
+    template<typename Query, typename Graph, typename TargetLabel,
+             typename VertexMatcher = impl::AlwaysMatch,
+             typename EdgeMatcher = impl::AlwaysMatch>
+    std::size_t countIsomorphisms(const MatchPlan<Query> &plan,
+        const Graph &graph, TargetLabel targetLabel, SubgraphScreen &screen,
+        VertexMatcher vertexMatcher = VertexMatcher(),
+        EdgeMatcher edgeMatcher = EdgeMatcher())
+    {
+      return impl::countIsomorphisms(plan, graph, screen, targetLabel,
+          vertexMatcher, edgeMatcher);
+    }
+
+    /**
+     * @brief Check if query is a subgraph of graph.
+     *
+     * The search stops at the first isomorphism.
+     */
+    template<typename Query, typename Graph,
+             typename VertexMatcher = impl::AlwaysMatch,
+             typename EdgeMatcher = impl::AlwaysMatch>
+    bool hasIsomorphism(const Query &query, const Graph &graph,
+        VertexMatcher vertexMatcher = VertexMatcher(),
+        EdgeMatcher edgeMatcher = EdgeMatcher())
+    {
+      MatchPlan<Query> plan(query);
+      SubgraphScreen screen;
+      return impl::hasIsomorphism(plan, graph, screen,
+          impl::NoVertexLabel(), vertexMatcher, edgeMatcher);
+    }
+
+    /**
+     * @brief Check if a query is a subgraph of graph using a precomputed
+     *        MatchPlan.
+     */
+    template<typename Query, typename Graph,
+             typename VertexMatcher = impl::AlwaysMatch,
+             typename EdgeMatcher = impl::AlwaysMatch>
+    bool hasIsomorphism(const MatchPlan<Query> &plan, const Graph &graph,
+        VertexMatcher vertexMatcher = VertexMatcher(),
+        EdgeMatcher edgeMatcher = EdgeMatcher())
+    {
+      SubgraphScreen screen;
+      return impl::hasIsomorphism(plan, graph, screen,
+          impl::NoVertexLabel(), vertexMatcher, edgeMatcher);
+    }
+
+    /**
+     * @brief Check if a query is a subgraph of graph using a precomputed
+     *        MatchPlan and a screen.
+     */
+    template<typename Query, typename Graph,
+             typename VertexMatcher = impl::AlwaysMatch,
+             typename EdgeMatcher = impl::AlwaysMatch>
+    bool hasIsomorphism(const MatchPlan<Query> &plan, const Graph &graph,
+        SubgraphScreen &screen, VertexMatcher vertexMatcher = VertexMatcher(),
+        EdgeMatcher edgeMatcher = EdgeMatcher())
+    {
+      return impl::hasIsomorphism(plan, graph, screen,
+          impl::NoVertexLabel(), vertexMatcher, edgeMatcher);
+    }
+
+    /**
+     * @brief Check if a query is a subgraph of graph using a precomputed
+     *        MatchPlan, a screen and vertex labels.
+     */
+    template<typename Query, typename Graph, typename TargetLabel,
+             typename VertexMatcher = impl::AlwaysMatch,
+             typename EdgeMatcher = impl::AlwaysMatch>
+    bool hasIsomorphism(const MatchPlan<Query> &plan, const Graph &graph,
+        TargetLabel targetLabel, SubgraphScreen &screen,
+        VertexMatcher vertexMatcher = VertexMatcher(),
+        EdgeMatcher edgeMatcher = EdgeMatcher())
+    {
+      return impl::hasIsomorphism(plan, graph, screen, targetLabel,
+          vertexMatcher, edgeMatcher);
+    }
+
+    /**
+     * @brief Find the first subgraph isomorphism of query in graph.
+     *
+     * @param query The query graph.
+     * @param graph The queried graph.
+     * @param solution Set to the isomorphism if one is found.
+     *
+     * @return True if an isomorphism was found.
+     */
+    template<typename Query, typename Graph,
+             typename VertexMatcher = impl::AlwaysMatch,
+             typename EdgeMatcher = impl::AlwaysMatch>
+    bool firstIsomorphism(const Query &query, const Graph &graph,
+        VertexPropertyMap<Query, typename GraphTraits<Graph>::Vertex> &solution,
+        VertexMatcher vertexMatcher = VertexMatcher(),
+        EdgeMatcher edgeMatcher = EdgeMatcher())
+    {
+      MatchPlan<Query> plan(query);
+      bool found = false;
+      auto visitor = [&] (const MappingView<Query, Graph> &mapping) {
+        solution = mapping.toPropertyMap();
+        found = true;
+        return true;
+      };
+      SubgraphScreen screen;
+      impl::isomorphismMappings(plan, graph, visitor, screen,
+          impl::NoVertexLabel(), vertexMatcher, edgeMatcher);
+      return found;
+    }
+
+    /**
+     * @brief Find the subgraph isomorphisms of query in graph using multiple
+     *        threads.
+     *
+     * The search tree is divided by the graph vertex that the first query
+     * vertex is mapped to and these subtrees are distributed over the
+     * threads (with work stealing). This speeds up searches in a single
+     * large graph (e.g. a protein).
+     *
+     * The visitor is called as visitor(mapping, thread) where mapping is a
+     * MappingView<Query, Graph> and thread is in the range [0, numThreads).
+     * The visitor is called concurrently and in no specific order, so it
+     * must be thread safe (e.g. store results per thread). When the visitor
+     * returns true, the search is stopped in all threads. The matchers are
+     * also called concurrently.
+     *
+     * @param query The query graph.
+     * @param graph The queried graph.
+     * @param visitor The visitor.
+     * @param numThreads The number of threads, 0 to use hardwareThreads().
+     */
+    template<typename Query, typename Graph, typename Visitor,
+             typename VertexMatcher = impl::AlwaysMatch,
+             typename EdgeMatcher = impl::AlwaysMatch>
+    void isomorphismsParallel(const Query &query, const Graph &graph,
+        Visitor visitor, unsigned int numThreads = 0,
+        VertexMatcher vertexMatcher = VertexMatcher(),
+        EdgeMatcher edgeMatcher = EdgeMatcher())
+    {
+      MatchPlan<Query> plan(query);
+      isomorphismsParallel(plan, graph, visitor, numThreads, vertexMatcher,
+          edgeMatcher);
+    }
+
+    /**
+     * @brief Find the subgraph isomorphisms of a query using a precomputed
+     *        MatchPlan and multiple threads.
+     */
+    template<typename Query, typename Graph, typename Visitor,
+             typename VertexMatcher = impl::AlwaysMatch,
+             typename EdgeMatcher = impl::AlwaysMatch>
+    void isomorphismsParallel(const MatchPlan<Query> &plan, const Graph &graph,
+        Visitor visitor, unsigned int numThreads = 0,
+        VertexMatcher vertexMatcher = VertexMatcher(),
+        EdgeMatcher edgeMatcher = EdgeMatcher())
+    {
+      SubgraphScreen screen;
+      isomorphismsParallel(plan, graph, visitor, screen, numThreads,
+          vertexMatcher, edgeMatcher);
+    }
+
+    /**
+     * @brief Find the subgraph isomorphisms of a query using a precomputed
+     *        MatchPlan, a screen and multiple threads.
+     *
+     * The graph is screened once before the threads are started, if the
+     * screen rejects the graph no threads are started.
+     */
+    template<typename Query, typename Graph, typename Visitor,
+             typename VertexMatcher = impl::AlwaysMatch,
+             typename EdgeMatcher = impl::AlwaysMatch>
+    void isomorphismsParallel(const MatchPlan<Query> &plan, const Graph &graph,
+        Visitor visitor, SubgraphScreen &screen, unsigned int numThreads = 0,
+        VertexMatcher vertexMatcher = VertexMatcher(),
+        EdgeMatcher edgeMatcher = EdgeMatcher())
+    {
+      auto goalVisitor = [&visitor] (const impl::VF2State<Query, Graph,
+          VertexMatcher, EdgeMatcher> &state, unsigned int thread) {
+        return visitor(state.mapping(), thread);
+      };
+      impl::searchIsomorphismsParallel(plan, graph, goalVisitor, screen,
+          numThreads, vertexMatcher, edgeMatcher);
+    }
+
+    /**
+     * @brief Count the subgraph isomorphisms of query in graph using multiple
+     *        threads.
+     *
+     * @param query The query graph.
+     * @param graph The queried graph.
+     * @param numThreads The number of threads, 0 to use hardwareThreads().
+     */
+    template<typename Query, typename Graph,
+             typename VertexMatcher = impl::AlwaysMatch,
+             typename EdgeMatcher = impl::AlwaysMatch>
+    std::size_t countIsomorphismsParallel(const Query &query,
+        const Graph &graph, unsigned int numThreads = 0,
+        VertexMatcher vertexMatcher = VertexMatcher(),
+        EdgeMatcher edgeMatcher = EdgeMatcher())
+    {
+      MatchPlan<Query> plan(query);
+      return countIsomorphismsParallel(plan, graph, numThreads,
+          vertexMatcher, edgeMatcher);
+    }
+
+    /**
+     * @brief Count the subgraph isomorphisms of a query using a precomputed
+     *        MatchPlan and multiple threads.
+     */
+    template<typename Query, typename Graph,
+             typename VertexMatcher = impl::AlwaysMatch,
+             typename EdgeMatcher = impl::AlwaysMatch>
+    std::size_t countIsomorphismsParallel(const MatchPlan<Query> &plan,
+        const Graph &graph, unsigned int numThreads = 0,
+        VertexMatcher vertexMatcher = VertexMatcher(),
+        EdgeMatcher edgeMatcher = EdgeMatcher())
+    {
+      SubgraphScreen screen;
+      return impl::countIsomorphismsParallel(plan, graph, screen, numThreads,
+          vertexMatcher, edgeMatcher);
+    }
+
+    /**
+     * @brief Count the subgraph isomorphisms of a query using a precomputed
+     *        MatchPlan, a screen and multiple threads.
+     */
+    template<typename Query, typename Graph,
+             typename VertexMatcher = impl::AlwaysMatch,
+             typename EdgeMatcher = impl::AlwaysMatch>
+    std::size_t countIsomorphismsParallel(const MatchPlan<Query> &plan,
+        const Graph &graph, SubgraphScreen &screen,
+        unsigned int numThreads = 0,
+        VertexMatcher vertexMatcher = VertexMatcher(),
+        EdgeMatcher edgeMatcher = EdgeMatcher())
+    {
+      return impl::countIsomorphismsParallel(plan, graph, screen, numThreads,
+          vertexMatcher, edgeMatcher);
+    }
+
+    /**
+     * @brief Check if query is a subgraph of graph using multiple threads.
+     *
+     * All threads stop as soon as one thread finds an isomorphism.
+     *
+     * @param query The query graph.
+     * @param graph The queried graph.
+     * @param numThreads The number of threads, 0 to use hardwareThreads().
+     */
+    template<typename Query, typename Graph,
+             typename VertexMatcher = impl::AlwaysMatch,
+             typename EdgeMatcher = impl::AlwaysMatch>
+    bool hasIsomorphismParallel(const Query &query, const Graph &graph,
+        unsigned int numThreads = 0,
+        VertexMatcher vertexMatcher = VertexMatcher(),
+        EdgeMatcher edgeMatcher = EdgeMatcher())
+    {
+      MatchPlan<Query> plan(query);
+      return hasIsomorphismParallel(plan, graph, numThreads,
+          vertexMatcher, edgeMatcher);
+    }
+
+    /**
+     * @brief Check if a query is a subgraph of graph using a precomputed
+     *        MatchPlan and multiple threads.
+     */
+    template<typename Query, typename Graph,
+             typename VertexMatcher = impl::AlwaysMatch,
+             typename EdgeMatcher = impl::AlwaysMatch>
+    bool hasIsomorphismParallel(const MatchPlan<Query> &plan,
+        const Graph &graph, unsigned int numThreads = 0,
+        VertexMatcher vertexMatcher = VertexMatcher(),
+        EdgeMatcher edgeMatcher = EdgeMatcher())
+    {
+      SubgraphScreen screen;
+      return impl::hasIsomorphismParallel(plan, graph, screen, numThreads,
+          vertexMatcher, edgeMatcher);
+    }
+
+    /**
+     * @brief Check if a query is a subgraph of graph using a precomputed
+     *        MatchPlan, a screen and multiple threads.
+     */
+    template<typename Query, typename Graph,
+             typename VertexMatcher = impl::AlwaysMatch,
+             typename EdgeMatcher = impl::AlwaysMatch>
+    bool hasIsomorphismParallel(const MatchPlan<Query> &plan,
+        const Graph &graph, SubgraphScreen &screen,
+        unsigned int numThreads = 0,
+        VertexMatcher vertexMatcher = VertexMatcher(),
+        EdgeMatcher edgeMatcher = EdgeMatcher())
+    {
+      return impl::hasIsomorphismParallel(plan, graph, screen, numThreads,
+          vertexMatcher, edgeMatcher);
+    }
+
+    /**
+     * @brief Count the subgraph isomorphisms of a query in many target graphs
+     *        using multiple threads.
+     *
+     * The query is compiled once (MatchPlan) and every thread reuses a single
+     * search state for all of its targets. The targets are scheduled
+     * dynamically (work stealing), so a few expensive targets do not stall
+     * the other threads.
+     *
+     * The targets can be any random access range of graphs (i.e.
+     * targets.size() and targets[i] are used, e.g. std::vector<Graph>).
+     *
+     * Targets rejected by the screen are not searched. Every thread uses a
+     * copy of the screen (the custom tests are called concurrently) and the
+     * counters of the copies are added to the screen when all targets are
+     * done.
+     *
+     * If the plan has a label histogram (see MatchPlan::computeLabels()),
+     * the targets' label histograms are computed with targetLabel, which is
+     * called as targetLabel(vertex) for the vertices of all targets
+     * (concurrently).
+     *
+     * @param plan The query's plan.
+     * @param targets The target graphs.
+     * @param targetLabel The vertex label of the targets.
+     * @param screen The screen.
+     * @param numThreads The number of threads, 0 to use hardwareThreads().
+     *
+     * @return The number of isomorphisms for each target.
+     */
+    template<typename Query, typename Targets, typename TargetLabel,
+             typename VertexMatcher = impl::AlwaysMatch,
+             typename EdgeMatcher = impl::AlwaysMatch>
+    std::vector<std::size_t> countIsomorphismsBatch(const MatchPlan<Query> &plan,
+        const Targets &targets, TargetLabel targetLabel,
+        SubgraphScreen &screen, unsigned int numThreads = 0,
+        VertexMatcher vertexMatcher = VertexMatcher(),
+        EdgeMatcher edgeMatcher = EdgeMatcher())
+    {
+      using State = impl::VF2State<Query, impl::TargetGraph<Targets>,
+            VertexMatcher, EdgeMatcher>;
+
+      std::vector<std::size_t> counts(targets.size(), 0);
+      auto visitor = [&counts] (State &state, std::size_t i) {
+        BacktrackSearch<State> search(state);
+        while (search.next())
+          ++counts[i];
+      };
+      impl::searchBatch(plan, targets, visitor, screen, targetLabel,
+          numThreads, vertexMatcher, edgeMatcher);
+
+      return counts;
+    }
+
+    /**
+     * @brief Count the subgraph isomorphisms of a query in many target graphs
+     *        using multiple threads and a screen without labels.
+     */
+    template<typename Query, typename Targets,
+             typename VertexMatcher = impl::AlwaysMatch,
+             typename EdgeMatcher = impl::AlwaysMatch>
+    std::vector<std::size_t> countIsomorphismsBatch(const MatchPlan<Query> &plan,
+        const Targets &targets, SubgraphScreen &screen,
+        unsigned int numThreads = 0,
+        VertexMatcher vertexMatcher = VertexMatcher(),
+        EdgeMatcher edgeMatcher = EdgeMatcher())
+    {
+      return countIsomorphismsBatch(plan, targets, impl::NoVertexLabel(),
+          screen, numThreads, vertexMatcher, edgeMatcher);
+    }
+
+    /**
+     * @brief Count the subgraph isomorphisms of a query in many target graphs
+     *        using multiple threads and the default screen.
+     */
+    template<typename Query, typename Targets,
+             typename VertexMatcher = impl::AlwaysMatch,
+             typename EdgeMatcher = impl::AlwaysMatch>
+    std::vector<std::size_t> countIsomorphismsBatch(const MatchPlan<Query> &plan,
+        const Targets &targets, unsigned int numThreads = 0,
+        VertexMatcher vertexMatcher = VertexMatcher(),
+        EdgeMatcher edgeMatcher = EdgeMatcher())
+    {
+      SubgraphScreen screen;
+      return countIsomorphismsBatch(plan, targets, screen, numThreads,
+          vertexMatcher, edgeMatcher);
+    }
+
+    /**
+     * @brief Check which target graphs contain a query using multiple
+     *        threads.
+     *
+     * The search in a target stops at the first isomorphism. See
+     * countIsomorphismsBatch() for details.
+     *
+     * @return A flag (0 or 1) for each target.
+     */
+    template<typename Query, typename Targets, typename TargetLabel,
+             typename VertexMatcher = impl::AlwaysMatch,
+             typename EdgeMatcher = impl::AlwaysMatch>
+    std::vector<char> hasIsomorphismBatch(const MatchPlan<Query> &plan,
+        const Targets &targets, TargetLabel targetLabel,
+        SubgraphScreen &screen, unsigned int numThreads = 0,
+        VertexMatcher vertexMatcher = VertexMatcher(),
+        EdgeMatcher edgeMatcher = EdgeMatcher())
+    {
+      using State = impl::VF2State<Query, impl::TargetGraph<Targets>,
+            VertexMatcher, EdgeMatcher>;
+
+      std::vector<char> hits(targets.size(), 0);
+      auto visitor = [&hits] (State &state, std::size_t i) {
+        BacktrackSearch<State> search(state);
+        if (search.next()) {
+          hits[i] = 1;
+          search.stop();
+        }
+      };
+      impl::searchBatch(plan, targets, visitor, screen, targetLabel,
+          numThreads, vertexMatcher, edgeMatcher);
+
+      return hits;
+    }
+
+    /**
+     * @brief Check which target graphs contain a query using multiple
+     *        threads and a screen without labels.
+     */
+    template<typename Query, typename Targets,
+             typename VertexMatcher = impl::AlwaysMatch,
+             typename EdgeMatcher = impl::AlwaysMatch>
+    std::vector<char> hasIsomorphismBatch(const MatchPlan<Query> &plan,
+        const Targets &targets, SubgraphScreen &screen,
+        unsigned int numThreads = 0,
+        VertexMatcher vertexMatcher = VertexMatcher(),
+        EdgeMatcher edgeMatcher = EdgeMatcher())
+    {
+      return hasIsomorphismBatch(plan, targets, impl::NoVertexLabel(), screen,
+          numThreads, vertexMatcher, edgeMatcher);
+    }
+
+    /**
+     * @brief Check which target graphs contain a query using multiple
+     *        threads and the default screen.
+     */
+    template<typename Query, typename Targets,
+             typename VertexMatcher = impl::AlwaysMatch,
+             typename EdgeMatcher = impl::AlwaysMatch>
+    std::vector<char> hasIsomorphismBatch(const MatchPlan<Query> &plan,
+        const Targets &targets, unsigned int numThreads = 0,
+        VertexMatcher vertexMatcher = VertexMatcher(),
+        EdgeMatcher edgeMatcher = EdgeMatcher())
     {
-      impl::isomorphisms<Query, Graph>(query, graph, visitor);
+      SubgraphScreen screen;
+      return hasIsomorphismBatch(plan, targets, screen, numThreads,
+          vertexMatcher, edgeMatcher);
     }
 
+    /**
+     * @brief Find the first subgraph isomorphism of a query in many target
+     *        graphs using multiple threads.
+     *
+     * See countIsomorphismsBatch() for details.
+     *
+     * @return The first isomorphism for each target. For targets without an
+     *         isomorphism, all query vertices are mapped to a null vertex.
+     */
+    template<typename Query, typename Targets, typename TargetLabel,
+             typename VertexMatcher = impl::AlwaysMatch,
+             typename EdgeMatcher = impl::AlwaysMatch>
+    std::vector<VertexPropertyMap<Query, typename GraphTraits<
+        impl::TargetGraph<Targets>>::Vertex>>
+    firstIsomorphismBatch(const MatchPlan<Query> &plan, const Targets &targets,
+        TargetLabel targetLabel, SubgraphScreen &screen,
+        unsigned int numThreads = 0,
+        VertexMatcher vertexMatcher = VertexMatcher(),
+        EdgeMatcher edgeMatcher = EdgeMatcher())
+    {
+      using Graph = impl::TargetGraph<Targets>;
+      using State = impl::VF2State<Query, Graph, VertexMatcher, EdgeMatcher>;
+
+      std::vector<VertexPropertyMap<Query, typename GraphTraits<Graph>::Vertex>>
+        solutions(targets.size(), VertexPropertyMap<Query,
+            typename GraphTraits<Graph>::Vertex>(plan.query(),
+              nullVertex<Graph>()));
+      auto visitor = [&solutions] (State &state, std::size_t i) {
+        BacktrackSearch<State> search(state);
+        if (search.next()) {
+          solutions[i] = state.solution();
+          search.stop();
+        }
+      };
+      impl::searchBatch(plan, targets, visitor, screen, targetLabel,
+          numThreads, vertexMatcher, edgeMatcher);
+
+      return solutions;
+    }
+
+    /**
+     * @brief Find the first subgraph isomorphism of a query in many target
+     *        graphs using multiple threads and a screen without labels.
+     */
+    template<typename Query, typename Targets,
+             typename VertexMatcher = impl::AlwaysMatch,
+             typename EdgeMatcher = impl::AlwaysMatch>
+    std::vector<VertexPropertyMap<Query, typename GraphTraits<
+        impl::TargetGraph<Targets>>::Vertex>>
+    firstIsomorphismBatch(const MatchPlan<Query> &plan, const Targets &targets,
+        SubgraphScreen &screen, unsigned int numThreads = 0,
+        VertexMatcher vertexMatcher = VertexMatcher(),
+        EdgeMatcher edgeMatcher = EdgeMatcher())
+    {
+      return firstIsomorphismBatch(plan, targets, impl::NoVertexLabel(), screen,
+          numThreads, vertexMatcher, edgeMatcher);
+    }
+
+    /**
+     * @brief Find the first subgraph isomorphism of a query in many target
+     *        graphs using multiple threads and the default screen.
+     */
+    template<typename Query, typename Targets,
+             typename VertexMatcher = impl::AlwaysMatch,
+             typename EdgeMatcher = impl::AlwaysMatch>
+    std::vector<VertexPropertyMap<Query, typename GraphTraits<
+        impl::TargetGraph<Targets>>::Vertex>>
+    firstIsomorphismBatch(const MatchPlan<Query> &plan, const Targets &targets,
+        unsigned int numThreads = 0,
+        VertexMatcher vertexMatcher = VertexMatcher(),
+        EdgeMatcher edgeMatcher = EdgeMatcher())
+    {
+      SubgraphScreen screen;
+      return firstIsomorphismBatch(plan, targets, screen, numThreads,
+          vertexMatcher, edgeMatcher);
+    }
+
+    /**
+     * @brief Count the subgraph isomorphisms of a query in many target graphs
+     *        using multiple threads.
+     */
+    template<typename Query, typename Targets,
+             typename VertexMatcher = impl::AlwaysMatch,
+             typename EdgeMatcher = impl::AlwaysMatch>
+    std::vector<std::size_t> countIsomorphismsBatch(const Query &query,
+        const Targets &targets, unsigned int numThreads = 0,
+        VertexMatcher vertexMatcher = VertexMatcher(),
+        EdgeMatcher edgeMatcher = EdgeMatcher())
+    {
+      MatchPlan<Query> plan(query);
+      return countIsomorphismsBatch(plan, targets, numThreads, vertexMatcher,
+          edgeMatcher);
+    }
+
+    /**
+     * @brief Check which target graphs contain a query using multiple
+     *        threads.
+     */
+    template<typename Query, typename Targets,
+             typename VertexMatcher = impl::AlwaysMatch,
+             typename EdgeMatcher = impl::AlwaysMatch>
+    std::vector<char> hasIsomorphismBatch(const Query &query,
+        const Targets &targets, unsigned int numThreads = 0,
+        VertexMatcher vertexMatcher = VertexMatcher(),
+        EdgeMatcher edgeMatcher = EdgeMatcher())
+    {
+      MatchPlan<Query> plan(query);
+      return hasIsomorphismBatch(plan, targets, numThreads, vertexMatcher,
+          edgeMatcher);
+    }
+
+    /**
+     * @class IsomorphismSearch Isomorphisms.h <ocgl/algorithm/Isomorphisms.h>
+     * @brief Resumable subgraph isomorphism search.
+     *
+     * Instead of calling a visitor, the isomorphisms are pulled one at a time
+     * using next(). The search uses an explicit stack (BacktrackSearch), so
+     * it can be suspended between calls and the query size is not limited by
+     * the stack size. A node or time limit can be set to abort pathological
+     * searches.
+     *
+     * @code
+     * IsomorphismSearch<Query, Graph> search(query, graph);
+     * search.setLimits(1000000);
+     * while (search.next())
+     *   process(search.mapping());
+     * if (search.aborted())
+     *   ...
+     * @endcode
+     */
+    template<typename Query, typename Graph,
+             typename VertexMatcher = impl::AlwaysMatch,
+             typename EdgeMatcher = impl::AlwaysMatch>
+    class IsomorphismSearch
+    {
+      public:
+        /**
+         * @brief The search state type.
+         */
+        using State = impl::VF2State<Query, Graph, VertexMatcher, EdgeMatcher>;
+        /**
+         * @brief The clock used for the time limit.
+         */
+        using Clock = typename BacktrackSearch<State>::Clock;
+
+        /**
+         * @brief Constructor.
+         */
+        IsomorphismSearch(const Query &query, const Graph &graph,
+            VertexMatcher vertexMatcher = VertexMatcher(),
+            EdgeMatcher edgeMatcher = EdgeMatcher())
+          : m_state(query, graph, vertexMatcher, edgeMatcher), m_search(m_state)
+        {
+        }
+
+        /**
+         * @brief Constructor using a precomputed plan.
+         */
+        IsomorphismSearch(const MatchPlan<Query> &plan, const Graph &graph,
+            VertexMatcher vertexMatcher = VertexMatcher(),
+            EdgeMatcher edgeMatcher = EdgeMatcher())
+          : m_state(plan, graph, vertexMatcher, edgeMatcher), m_search(m_state)
+        {
+        }
+
+        IsomorphismSearch(const IsomorphismSearch&) = delete;
+        IsomorphismSearch& operator=(const IsomorphismSearch&) = delete;
+
+        /**
+         * @brief Only map query vertices to graph vertices in their domain
+         *        (see CandidateDomains).
+         *
+         * Must be called before the first call to next(). The domains must
+         * outlive the search.
+         */
+        void setDomains(const CandidateDomains<Query, Graph> &domains)
+        {
+          m_state.setDomains(&domains);
+        }
+
+        /**
+         * @brief Set the node and time limits (0 for no limit).
+         */
+        void setLimits(std::size_t maxNodes,
+            typename Clock::duration maxTime = Clock::duration::zero())
+        {
+          m_search.setLimits(maxNodes, maxTime);
+        }
+
+        /**
+         * @brief Find the next isomorphism.
+         *
+         * @return True if an isomorphism was found.
+         */
+        bool next()
+        {
+          return m_search.next();
+        }
+
+        /**
+         * @brief Get the current isomorphism (valid until the next call to
+         *        next()).
+         */
+        MappingView<Query, Graph> mapping() const
+        {
+          return m_state.mapping();
+        }
+
+        /**
+         * @brief Copy the current isomorphism to a property map.
+         */
+        VertexPropertyMap<Query, typename GraphTraits<Graph>::Vertex>
+        solution() const
+        {
+          return m_state.solution();
+        }
+
+        /**
+         * @brief Check if the search was aborted because a limit was exceeded.
+         */
+        bool aborted() const
+        {
+          return m_search.aborted();
+        }
+
+        /**
+         * @brief Get the number of visited nodes.
+         */
+        std::size_t numNodes() const
+        {
+          return m_search.numNodes();
+        }
+
+      private:
+        State m_state;
+        BacktrackSearch<State> m_search;
+    };
+
   } // namespace algorithm
 
 } // namespace ocgl
 
 #endif // OCGL_ALGORITHM_ISOMORPHISM_H
-
@@ -0,0 +1,347 @@
+#ifndef OCGL_ALGORITHM_MATCH_PLAN_H
+#define OCGL_ALGORITHM_MATCH_PLAN_H
+
+#include <ocgl/algorithm/SubgraphInvariants.h>
+#include <ocgl/PropertyMap.h>
+#include <ocgl/Range.h>
+
+#include <limits>
+#include <queue>
+#include <tuple>
+#include <vector>
+
+/**
+ * @file MatchPlan.h
+ * @brief Precomputed matching order for subgraph isomorphism.
+ */
+
+namespace ocgl {
+
+  namespace algorithm {
+
+    namespace impl {
+
+      /**
+       * @brief Matcher that accepts all vertex or edge pairs.
+       *
+       * This is the default matcher for VF2State. The call is inlined and
+       * removed by the compiler.
+       */
+      struct AlwaysMatch
+      {
+        template<typename QueryVertexOrEdge, typename GraphVertexOrEdge>
+        constexpr bool operator()(const QueryVertexOrEdge&,
+            const GraphVertexOrEdge&) const
+        {
+          return true;
+        }
+      };
+
+    } // namespace impl
+
+    /**
+     * @class MatchPlan MatchPlan.h <ocgl/algorithm/MatchPlan.h>
+     * @brief Precomputed matching order for subgraph isomorphism.
+     *
+     * The order in which the query vertices are matched has a large effect on
+     * the size of the search tree. The MatchPlan orders the query vertices
+     * once (similar to VF2++ and RI) so the order does not depend on how the
+     * query happens to be numbered:
+     *
+     * - The first vertex of each connected component is the rarest vertex
+     *   (lowest frequency), ties are broken by highest degree.
+     * - The next vertex is the unordered vertex with the most ordered
+     *   neighbours, ties are broken by lowest frequency and highest degree.
+     *
+     * For each depth, the plan stores the query vertex, the parent (an
+     * ordered neighbour or a null vertex for the first vertex of a component)
+     * and the edges to the ordered neighbours that have to be checked when
+     * the vertex is mapped. The search only has to consider the graph
+     * neighbours of the parent's image as candidates.
+     *
+     * A plan only depends on the query, so it can be reused for matching the
+     * query against many graphs. The frequencies can be used to prefer query
+     * vertices with labels that are rare in the graphs (e.g. the number of
+     * atoms with the same element in a database).
+     *
+     * The plan also caches the SubgraphInvariants of the query, so targets
+     * can be screened without recomputing them (see SubgraphScreen). The
+     * cycle counts and label histogram are only included when computed
+     * (see computeCycles() and computeLabels()), otherwise the query's cycle
+     * counts are computed by the search when the cheaper tests pass.
+     *
+     * The query must outlive the plan.
+     */
+    template<typename Query>
+    class MatchPlan
+    {
+      public:
+        /**
+         * @brief The query vertex type.
+         */
+        using Vertex = typename GraphTraits<Query>::Vertex;
+        /**
+         * @brief The query edge type.
+         */
+        using Edge = typename GraphTraits<Query>::Edge;
+
+        /**
+         * @brief An edge to an ordered neighbour.
+         */
+        struct Check
+        {
+          /**
+           * @brief The ordered neighbour.
+           */
+          Vertex vertex;
+          /**
+           * @brief The edge between the vertex and the ordered neighbour.
+           */
+          Edge edge;
+        };
+
+        /**
+         * @brief Constructor for an empty plan without query.
+         *
+         * This does not allocate memory, the plan can be assigned later.
+         */
+        MatchPlan() : m_query(nullptr)
+        {
+        }
+
+        /**
+         * @brief Constructor.
+         *
+         * All vertices are considered to be equally rare.
+         *
+         * @param query The query graph.
+         */
+        explicit MatchPlan(const Query &query)
+          : m_query(&query), m_invariants(query)
+        {
+          compute(VertexPropertyMap<Query, unsigned int>(query, 0));
+        }
+
+        /**
+         * @brief Constructor.
+         *
+         * @param query The query graph.
+         * @param frequency The frequency of each query vertex's label, lower
+         *        values are matched first.
+         */
+        MatchPlan(const Query &query,
+            const VertexPropertyMap<Query, unsigned int> &frequency)
+          : m_query(&query), m_invariants(query)
+        {
+          compute(frequency);
+        }
+
+        /**
+         * @brief Get the query graph.
+         */
+        const Query& query() const
+        {
+          return *m_query;
+        }
+
+        /**
+         * @brief Get the invariants of the query.
+         *
+         * The cycle counts and label histogram are only included when
+         * computeCycles() and computeLabels() have been called.
+         */
+        const SubgraphInvariants& invariants() const
+        {
+          return m_invariants;
+        }
+
+        /**
+         * @brief Compute the cycle counts of the query.
+         *
+         * This avoids computing them again in every search that runs the
+         * SubgraphScreen::CycleCount test.
+         */
+        void computeCycles()
+        {
+          m_invariants.computeCycles(*m_query);
+        }
+
+        /**
+         * @brief Compute the cycle counts of the query from a precomputed
+         *        cycle membership.
+         *
+         * @param cyclic The cycle membership (see cycleMembership()).
+         */
+        void computeCycles(const VertexEdgePropertyMap<Query, bool> &cyclic)
+        {
+          m_invariants.computeCycles(*m_query, cyclic);
+        }
+
+        /**
+         * @brief Compute the label histogram of the query.
+         *
+         * Searches that are given a target label (e.g. the
+         * countIsomorphisms() overload with a TargetLabel) compare the
+         * histograms using the SubgraphScreen::LabelHistogram test.
+         *
+         * @param label Function object with signature unsigned int(Vertex)
+         *        (e.g. the element of an atom).
+         */
+        template<typename VertexLabel>
+        void computeLabels(VertexLabel label)
+        {
+          m_invariants.computeLabels(*m_query, label);
+        }
+
+        /**
+         * @brief Get the number of depths (i.e. number of query vertices).
+         */
+        unsigned int size() const
+        {
+          return m_order.size();
+        }
+
+        /**
+         * @brief Get the query vertex that is matched at a depth.
+         */
+        Vertex vertex(unsigned int depth) const
+        {
+          return m_order[depth];
+        }
+
+        /**
+         * @brief Get the parent of the query vertex that is matched at a depth.
+         *
+         * @return The parent or a null vertex if the vertex is the first
+         *         vertex of a connected component.
+         */
+        Vertex parent(unsigned int depth) const
+        {
+          return m_parent[depth];
+        }
+
+        /**
+         * @brief Get the depth at which a query vertex is matched.
+         */
+        unsigned int depth(Vertex u) const
+        {
+          return m_depth[getVertexIndex(*m_query, u)];
+        }
+
+        /**
+         * @brief Get the edges to the ordered neighbours of the query vertex
+         *        that is matched at a depth.
+         */
+        Range<typename std::vector<Check>::const_iterator>
+        checks(unsigned int depth) const
+        {
+          return makeRange(m_checks.begin() + m_offsets[depth],
+              m_checks.begin() + m_offsets[depth + 1]);
+        }
+
+      private:
+        /**
+         * @brief Compute the order, parents and checks.
+         */
+        void compute(const VertexPropertyMap<Query, unsigned int> &frequency)
+        {
+          const Query &g = *m_query;
+          auto n = numVertices(g);
+          auto unordered = std::numeric_limits<unsigned int>::max();
+
+          m_order.reserve(n);
+          m_parent.reserve(n);
+          m_depth.assign(n, unordered);
+          m_offsets.reserve(n + 1);
+          m_offsets.push_back(0);
+
+          // the number of ordered neighbours for each vertex
+          std::vector<unsigned int> numOrdered(n, 0);
+
+          // candidates ranked by number of ordered neighbours, frequency,
+          // degree and index, higher is better (entries with an outdated
+          // number of ordered neighbours are skipped)
+          using Key = std::tuple<unsigned int, unsigned int, unsigned int,
+                unsigned int>;
+          auto key = [&] (Vertex v) {
+            auto vi = getVertexIndex(g, v);
+            return Key(numOrdered[vi],
+                std::numeric_limits<unsigned int>::max() - frequency[v],
+                getDegree(g, v), std::numeric_limits<unsigned int>::max() - vi);
+          };
+
+          // vertices without ordered neighbours are the roots for the next
+          // connected component
+          std::priority_queue<std::pair<Key, VertexIndex>> queue;
+          for (auto v : getVertices(g))
+            queue.emplace(key(v), getVertexIndex(g, v));
+
+          while (m_order.size() < n) {
+            auto bi = queue.top().second;
+            auto bestOrdered = std::get<0>(queue.top().first);
+            queue.pop();
+
+            if (m_depth[bi] != unordered || bestOrdered != numOrdered[bi])
+              continue;
+
+            Vertex best = getVertex(g, bi);
+            unsigned int d = m_order.size();
+            m_order.push_back(best);
+            m_depth[bi] = d;
+            m_parent.push_back(nullVertex<Query>());
+
+            for (auto e : getIncident(g, best)) {
+              auto w = getOther(g, e, best);
+              auto wi = getVertexIndex(g, w);
+              if (m_depth[wi] == unordered) {
+                ++numOrdered[wi];
+                queue.emplace(key(w), wi);
+                continue;
+              }
+
+              // the parent is the neighbour that was ordered first
+              m_checks.push_back(Check{w, e});
+              if (!isValidVertex(g, m_parent.back()) ||
+                  m_depth[wi] < depth(m_parent.back()))
+                m_parent.back() = w;
+            }
+
+            m_offsets.push_back(m_checks.size());
+          }
+        }
+
+        /**
+         * @brief The query graph.
+         */
+        const Query *m_query;
+        /**
+         * @brief The invariants of the query.
+         */
+        SubgraphInvariants m_invariants;
+        /**
+         * @brief The query vertex for each depth.
+         */
+        std::vector<Vertex> m_order;
+        /**
+         * @brief The parent for each depth.
+         */
+        std::vector<Vertex> m_parent;
+        /**
+         * @brief The depth for each query vertex (indexed by vertex index).
+         */
+        std::vector<unsigned int> m_depth;
+        /**
+         * @brief The edges to ordered neighbours for all depths.
+         */
+        std::vector<Check> m_checks;
+        /**
+         * @brief The offsets in m_checks for each depth.
+         */
+        std::vector<std::size_t> m_offsets;
+    };
+
+  } // namespace algorithm
+
+} // namespace ocgl
+
+#endif // OCGL_ALGORITHM_MATCH_PLAN_H
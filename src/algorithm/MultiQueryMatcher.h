@@ -0,0 +1,377 @@
+#ifndef OCGL_ALGORITHM_MULTI_QUERY_MATCHER_H
+#define OCGL_ALGORITHM_MULTI_QUERY_MATCHER_H
+
+#include <ocgl/algorithm/VF2State.h>
+#include <ocgl/algorithm/Backtrack.h>
+#include <ocgl/algorithm/SubgraphScreen.h>
+#include <ocgl/algorithm/TraversalWorkspace.h>
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+/**
+ * @file MultiQueryMatcher.h
+ * @brief Match many queries against the same target graphs.
+ */
+
+namespace ocgl {
+
+  namespace algorithm {
+
+    /**
+     * @class MultiQueryMatcher MultiQueryMatcher.h <ocgl/algorithm/MultiQueryMatcher.h>
+     * @brief Match many queries against the same target graphs.
+     *
+     * Screening a molecule for functional groups matches hundreds of small
+     * queries against the same target. The MultiQueryMatcher shares as much
+     * work as possible:
+     *
+     * - The queries are compiled once (MatchPlan, SubgraphInvariants and
+     *   cycle membership).
+     * - The target's invariants (counts and degree histogram) are computed
+     *   once per target by setTarget(). The target's cycle membership is
+     *   only computed if a query has cycles and is shared by the screen and
+     *   the domains. With domains, the per-vertex degrees are also computed
+     *   once per target (see TargetVertexData).
+     * - Queries rejected by the SubgraphScreen are skipped without a search.
+     *   The screen's tests can be configured with screen(). The label
+     *   histograms are only compared if labels are set for the query (see
+     *   setQueryLabels()) and the target (see setTarget()).
+     * - Optionally, CandidateDomains are computed for each query that passes
+     *   the screen (see setUseDomains()). Queries with an empty domain are
+     *   also skipped.
+     * - A single VF2State and CandidateDomains object is shared by all
+     *   queries and targets, only the plan is switched for each query. The
+     *   memory used for the target only grows when a larger target is seen
+     *   and does not depend on the number of queries.
+     *
+     * @code
+     * MultiQueryMatcher<Query, Graph> matcher(queries);
+     * std::vector<char> hits;
+     * for (const auto &molecule : molecules) {
+     *   matcher.match(molecule, hits);
+     *   ...
+     * }
+     * @endcode
+     *
+     * The queries must outlive the matcher.
+     */
+    template<typename Query, typename Graph,
+             typename VertexMatcher = impl::AlwaysMatch,
+             typename EdgeMatcher = impl::AlwaysMatch>
+    class MultiQueryMatcher
+    {
+      public:
+        /**
+         * @brief The search state type.
+         */
+        using State = impl::VF2State<Query, Graph, VertexMatcher, EdgeMatcher>;
+        /**
+         * @brief The candidate domains type.
+         */
+        using Domains = CandidateDomains<Query, Graph>;
+
+        /**
+         * @brief Constructor.
+         *
+         * @param queries The queries.
+         * @param vertexMatcher The vertex matcher (shared by all queries).
+         * @param edgeMatcher The edge matcher (shared by all queries).
+         */
+        explicit MultiQueryMatcher(const std::vector<Query> &queries,
+            VertexMatcher vertexMatcher = VertexMatcher(),
+            EdgeMatcher edgeMatcher = EdgeMatcher())
+          : m_target(nullptr), m_vertexMatcher(vertexMatcher),
+            m_edgeMatcher(edgeMatcher), m_cycles(false), m_useDomains(false),
+            m_numScreened(0), m_numSearched(0)
+        {
+          m_plans.reserve(queries.size());
+          m_queryCyclic.reserve(queries.size());
+          for (const auto &query : queries) {
+            m_plans.emplace_back(query);
+            // one DFS for the screen and the domains
+            m_queryCyclic.push_back(cycleMembership(query));
+            m_plans.back().computeCycles(m_queryCyclic.back());
+            if (m_plans.back().invariants().numCyclicEdges())
+              m_cycles = true;
+          }
+        }
+
+        MultiQueryMatcher(const MultiQueryMatcher&) = delete;
+        MultiQueryMatcher& operator=(const MultiQueryMatcher&) = delete;
+
+        /**
+         * @brief Get the number of queries.
+         */
+        std::size_t numQueries() const
+        {
+          return m_plans.size();
+        }
+
+        /**
+         * @brief Compute the label histogram of a query for the
+         *        SubgraphScreen::LabelHistogram test.
+         *
+         * @param query The query index.
+         * @param label Function object with signature unsigned int(Vertex)
+         *        (e.g. the element of an atom).
+         */
+        template<typename QueryLabel>
+        void setQueryLabels(std::size_t query, QueryLabel label)
+        {
+          m_plans[query].computeLabels(label);
+        }
+
+        /**
+         * @brief Use CandidateDomains to filter the candidates of the query
+         *        vertices.
+         *
+         * This is useful for labelled queries and large targets: the vertex
+         * matcher is called once per pair before the search instead of for
+         * every candidate pair during the search.
+         */
+        void setUseDomains(bool useDomains)
+        {
+          m_useDomains = useDomains;
+          // compute the per-vertex data for the current target
+          if (m_useDomains && m_target)
+            computeTargetData(false);
+        }
+
+        /**
+         * @brief Set the target graph and compute its invariants and
+         *        per-vertex data.
+         *
+         * The target has no label histogram, so the
+         * SubgraphScreen::LabelHistogram test passes for all queries.
+         *
+         * @param target The target graph (must outlive the searches).
+         */
+        void setTarget(const Graph &target)
+        {
+          m_target = &target;
+          computeTargetData(true);
+        }
+
+        /**
+         * @brief Set the target graph and compute its invariants (including
+         *        the label histogram) and per-vertex data.
+         *
+         * @param target The target graph (must outlive the searches).
+         * @param label Function object with signature unsigned int(Vertex)
+         *        (e.g. the element of an atom).
+         */
+        template<typename TargetLabel>
+        void setTarget(const Graph &target, TargetLabel label)
+        {
+          setTarget(target);
+          m_targetInvariants.computeLabels(target, label);
+        }
+
+        /**
+         * @brief Get the invariants of the current target.
+         */
+        const SubgraphInvariants& targetInvariants() const
+        {
+          return m_targetInvariants;
+        }
+
+        /**
+         * @brief Get the invariants of a query.
+         */
+        const SubgraphInvariants& queryInvariants(std::size_t query) const
+        {
+          return m_plans[query].invariants();
+        }
+
+        /**
+         * @brief Get the screen used to skip searches.
+         *
+         * The screen can be used to disable tests, add custom tests and to
+         * see how often each test rejected a query.
+         */
+        SubgraphScreen& screen()
+        {
+          return m_screen;
+        }
+
+        /**
+         * @brief Check if a query passes the invariant screen for the current
+         *        target.
+         */
+        bool mayMatch(std::size_t query)
+        {
+          return m_screen.mayContain(m_targetInvariants,
+              m_plans[query].invariants());
+        }
+
+        /**
+         * @brief Check if a query is a subgraph of the current target.
+         */
+        bool hasMatch(std::size_t query)
+        {
+          if (!screenQuery(query))
+            return false;
+
+          BacktrackSearch<State> search(state(query));
+          if (!search.next())
+            return false;
+
+          search.stop();
+          return true;
+        }
+
+        /**
+         * @brief Count the subgraph isomorphisms of a query in the current
+         *        target.
+         */
+        std::size_t countMatches(std::size_t query)
+        {
+          if (!screenQuery(query))
+            return 0;
+
+          BacktrackSearch<State> search(state(query));
+          std::size_t count = 0;
+          while (search.next())
+            ++count;
+
+          return count;
+        }
+
+        /**
+         * @brief Check which queries are subgraphs of a target.
+         *
+         * @param target The target graph.
+         * @param hits Set to a flag (0 or 1) for each query.
+         */
+        void match(const Graph &target, std::vector<char> &hits)
+        {
+          setTarget(target);
+          hits.resize(numQueries());
+          for (std::size_t i = 0; i < numQueries(); ++i)
+            hits[i] = hasMatch(i);
+        }
+
+        /**
+         * @brief Count the subgraph isomorphisms of all queries in a target.
+         *
+         * @param target The target graph.
+         * @param counts Set to the number of isomorphisms for each query.
+         */
+        void count(const Graph &target, std::vector<std::size_t> &counts)
+        {
+          setTarget(target);
+          counts.resize(numQueries());
+          for (std::size_t i = 0; i < numQueries(); ++i)
+            counts[i] = countMatches(i);
+        }
+
+        /**
+         * @brief Get the number of searches that were skipped by the
+         *        invariant screen or an empty domain.
+         */
+        std::size_t numScreened() const
+        {
+          return m_numScreened;
+        }
+
+        /**
+         * @brief Get the number of searches that were started.
+         */
+        std::size_t numSearched() const
+        {
+          return m_numSearched;
+        }
+
+      private:
+        /**
+         * @brief Compute the invariants (without labels) and the per-vertex
+         *        data of the current target.
+         */
+        void computeTargetData(bool invariants)
+        {
+          if (invariants)
+            m_targetInvariants.compute(*m_target);
+          if (m_useDomains)
+            m_targetData.computeDegrees(*m_target);
+
+          // one DFS for the screen and the domains
+          if (m_cycles) {
+            auto cyclic = cycleMembership(*m_target, m_workspace);
+            if (invariants)
+              m_targetInvariants.computeCycles(*m_target, cyclic);
+            if (m_useDomains)
+              m_targetData.computeCycles(*m_target, cyclic);
+          }
+        }
+
+        /**
+         * @brief Apply the invariant screen and update the counters.
+         */
+        bool screenQuery(std::size_t query)
+        {
+          if (!mayMatch(query)) {
+            ++m_numScreened;
+            return false;
+          }
+
+          if (m_useDomains) {
+            m_domains.setQuery(m_plans[query].query(), m_queryCyclic[query]);
+            m_domains.compute(*m_target, m_targetData, m_vertexMatcher,
+                m_edgeMatcher);
+            if (m_domains.isEmpty()) {
+              ++m_numScreened;
+              return false;
+            }
+          }
+
+          ++m_numSearched;
+          return true;
+        }
+
+        /**
+         * @brief Get the shared state, bound to the query and the current
+         *        target.
+         */
+        State& state(std::size_t query)
+        {
+          if (!m_state)
+            m_state.reset(new State(m_plans[query], *m_target, m_vertexMatcher,
+                  m_edgeMatcher));
+          else {
+            m_state->setGraph(*m_target);
+            m_state->setPlan(m_plans[query]);
+          }
+
+          if (m_useDomains)
+            m_state->setDomains(&m_domains);
+
+          return *m_state;
+        }
+
+        const Graph *m_target;
+        SubgraphInvariants m_targetInvariants;
+        TargetVertexData<Graph> m_targetData;
+        TraversalWorkspace<Graph> m_workspace;
+        VertexMatcher m_vertexMatcher;
+        EdgeMatcher m_edgeMatcher;
+        // per query data
+        std::vector<MatchPlan<Query>> m_plans;
+        std::vector<VertexEdgePropertyMap<Query, bool>> m_queryCyclic;
+        // shared by all queries
+        std::unique_ptr<State> m_state;
+        Domains m_domains;
+        SubgraphScreen m_screen;
+        // true if any query has cycles
+        bool m_cycles;
+        bool m_useDomains;
+        std::size_t m_numScreened;
+        std::size_t m_numSearched;
+    };
+
+  } // namespace algorithm
+
+} // namespace ocgl
+
+#endif // OCGL_ALGORITHM_MULTI_QUERY_MATCHER_H
@@ -5,12 +5,11 @@
 #include <ocgl/Cycle.h>
 #include <ocgl/CycleSpace.h>
 #include <ocgl/BitMatrix.h>
-#include <ocgl/algorithm/Dijkstra.h>
+#include <ocgl/Parallel.h>
+#include <ocgl/algorithm/ShortestPathWorkspace.h>
 #include <ocgl/algorithm/CycleMembership.h>
 
 #include <memory>
-//#include <thread>
-//#include <future>
 
 /**
  * @file RelevantCycles.h
@@ -23,55 +22,140 @@ namespace ocgl {
 
     namespace impl {
 
-      template<bool IsUndirected>
-      class AdjacencyMatrix
+      /**
+       * @brief The shortest path digraph Dr from the Vismara paper.
+       *
+       * The digraph Dr = (Vr, Ur) contains a directed edge (y, z) if z is the
+       * previous vertex of y on a shortest path from r to y. The edges are
+       * stored as predecessor lists in compressed sparse row format over the
+       * vertices in Vr, so the memory used is O(|Vr| + |Ur|). The vertices in
+       * Vr are identified by their position in Vr (i.e. the local index).
+       */
+      template<typename Graph>
+      class ShortestPathDAG
       {
         public:
-          AdjacencyMatrix(unsigned int numVertices)
-            : m_adjMatrix(numVertices * numVertices), m_numVertices(numVertices)
+          /**
+           * @brief The vertex type.
+           */
+          using Vertex = typename GraphTraits<Graph>::Vertex;
+
+          /**
+           * @brief Constructor.
+           *
+           * @param g The graph.
+           * @param Vr The vertices in Vr.
+           *
+           * @pre Vr is sorted by vertex index.
+           */
+          ShortestPathDAG(const Graph &g, const std::vector<Vertex> &Vr)
+            : m_graph(&g), m_vertices(Vr)
           {
+            m_offsets.reserve(Vr.size() + 1);
+            m_offsets.push_back(0);
           }
 
-          void addEdge(unsigned int source, unsigned int target)
+          /**
+           * @brief Get the number of vertices (i.e. |Vr|).
+           */
+          std::size_t numVertices() const
           {
-            m_adjMatrix[index(source, target)] = true;
+            return m_vertices.size();
+          }
 
-            if (IsUndirected)
-              m_adjMatrix[index(target, source)] = true;
+          /**
+           * @brief Get the number of edges (i.e. |Ur|).
+           */
+          std::size_t numEdges() const
+          {
+            return m_predecessors.size();
           }
 
-          bool isEdge(unsigned int source, unsigned int target) const
+          /**
+           * @brief Get the vertex for a local index.
+           */
+          Vertex vertex(Index local) const
           {
-            return m_adjMatrix[index(source, target)];
+            return m_vertices[local];
           }
 
-        private:
-          unsigned int index(unsigned int s, unsigned int t) const
+          /**
+           * @brief Get the local index for a vertex in Vr.
+           */
+          Index localIndex(Vertex v) const
           {
-            return s * m_numVertices + t;
+            auto vi = getVertexIndex(*m_graph, v);
+            return std::lower_bound(m_vertices.begin(), m_vertices.end(), vi,
+                [this] (Vertex u, Index i) {
+                  return getVertexIndex(*m_graph, u) < i;
+                }) - m_vertices.begin();
           }
 
-          std::vector<bool> m_adjMatrix;
-          unsigned int m_numVertices;
-      };
+          /**
+           * @brief Add the predecessors for the next vertex in Vr.
+           *
+           * This function must be called once for each vertex in Vr, in
+           * order.
+           *
+           * @param S The predecessors (i.e. all z such that (y, z) is in Ur).
+           */
+          void addPredecessors(const std::vector<Vertex> &S)
+          {
+            PRE_LT(m_offsets.size(), m_vertices.size() + 1);
+
+            auto begin = m_predecessors.size();
+            for (auto z : S)
+              m_predecessors.push_back(localIndex(z));
+            std::sort(m_predecessors.begin() + begin, m_predecessors.end());
 
-      using DirectedAdjacencyMatrix = AdjacencyMatrix<false>;
-      using UndirectedAdjacencyMatrix = AdjacencyMatrix<true>;
+            m_offsets.push_back(m_predecessors.size());
+          }
+
+          /**
+           * @brief Get the local indices of the predecessors of a vertex.
+           *
+           * @param local The local index of the vertex.
+           */
+          Range<std::vector<Index>::const_iterator> predecessors(Index local) const
+          {
+            auto begin = m_predecessors.begin();
+            return makeRange(begin + m_offsets[local],
+                begin + m_offsets[local + 1]);
+          }
+
+        private:
+          /**
+           * @brief The graph.
+           */
+          const Graph *m_graph;
+          /**
+           * @brief The vertices in Vr (local index -> vertex).
+           */
+          std::vector<Vertex> m_vertices;
+          /**
+           * @brief Local index -> offset in m_predecessors.
+           */
+          std::vector<Index> m_offsets;
+          /**
+           * @brief The predecessor local indices.
+           */
+          std::vector<Index> m_predecessors;
+      };
 
       template<typename Graph, typename Vertex>
-      bool pathsIntersectionIsSource(const Dijkstra<Graph> &dijkstra,
+      bool pathsIntersectionIsSource(const ShortestPathWorkspace<Graph> &paths,
           const Graph &g, Vertex y, Vertex z)
       {
         Vertex u = y;
 
-        while (isValidVertex(g, dijkstra.prev()[u])) {
+        while (isValidVertex(g, paths.prev(u))) {
           Vertex v = z;
-          while (isValidVertex(g, dijkstra.prev()[v])) {
+          while (isValidVertex(g, paths.prev(v))) {
             if (u == v)
               return false;
-            v = dijkstra.prev()[v];
+            v = paths.prev(v);
           }
-          u = dijkstra.prev()[u];
+          u = paths.prev(u);
         }
 
         return true;
@@ -114,7 +198,7 @@ namespace ocgl {
            */
           CycleFamily(const Graph &g, Vertex r, Vertex p, Vertex q,
               const VertexCycle<Graph> &prototype,
-              const std::shared_ptr<impl::DirectedAdjacencyMatrix> &Dr)
+              const std::shared_ptr<ShortestPathDAG<Graph>> &Dr)
             : m_graph(&g), m_r(r), m_p(p), m_q(q), m_x(nullVertex<Graph>()),
               m_prototype(prototype), m_Dr(Dr)
           {
@@ -131,7 +215,7 @@ namespace ocgl {
            */
           CycleFamily(const Graph &g, Vertex r, Vertex p, Vertex q, Vertex x,
               const VertexCycle<Graph> &prototype,
-              const std::shared_ptr<DirectedAdjacencyMatrix> &Dr)
+              const std::shared_ptr<ShortestPathDAG<Graph>> &Dr)
             : m_graph(&g), m_r(r), m_p(p), m_q(q), m_x(x),
               m_prototype(prototype), m_Dr(Dr)
           {
@@ -177,7 +261,10 @@ namespace ocgl {
             return m_prototype;
           }
 
-          const DirectedAdjacencyMatrix& Dr() const
+          /**
+           * @brief Get the shortest path digraph Dr.
+           */
+          const ShortestPathDAG<Graph>& Dr() const
           {
             return *m_Dr;
           }
@@ -272,21 +359,22 @@ namespace ocgl {
         private:
           /**
            * @brief Extend the current path from x to m_r.
+           *
+           * @param x The local index (in Dr) of the x vertex.
            */
-          void listPaths(Vertex x, VertexPath<Graph> &current,
+          void listPaths(Index x, VertexPath<Graph> &current,
               std::function<void(const VertexPath<Graph>&)> callback) const
           {
             // add v to the current path
-            current.push_back(x);
+            current.push_back(m_Dr->vertex(x));
 
-            if (x == m_r) {
+            if (current.back() == m_r) {
               // found a path (r .. x)
               callback(current);
             } else {
               // for any z such that (x, z) is in Ur
-              for (Index zi = 0; zi <= getVertexIndex(*m_graph, m_r); ++zi)
-                if (m_Dr->isEdge(getVertexIndex(*m_graph, x), zi))
-                  listPaths(getVertex(*m_graph, zi), current, callback);
+              for (auto z : m_Dr->predecessors(x))
+                listPaths(z, current, callback);
             }
 
             current.pop_back();
@@ -299,8 +387,8 @@ namespace ocgl {
               std::function<void(const VertexPath<Graph>&)> callback) const
           {
             VertexPath<Graph> current;
-            current.reserve(m_prototype.size() / 2);
-            listPaths(x, current, callback);
+            current.reserve(m_prototype.size() / 2 + 1);
+            listPaths(m_Dr->localIndex(x), current, callback);
           }
 
           const Graph *m_graph;
@@ -309,16 +397,49 @@ namespace ocgl {
           Vertex m_q;
           Vertex m_x;
           VertexCycle<Graph> m_prototype;
-          std::shared_ptr<DirectedAdjacencyMatrix> m_Dr;
+          std::shared_ptr<ShortestPathDAG<Graph>> m_Dr;
       };
 
       /**
-       * @brief Find the initial Vismara cycle families.
+       * @brief Scratch memory for finding the initial cycle families.
+       *
+       * The memory is reused for all roots (and graphs of similar size).
+       */
+      template<typename Graph>
+      struct CycleFamiliesWorkspace
+      {
+        using Vertex = typename GraphTraits<Graph>::Vertex;
+
+        /**
+         * @brief The vertices in Vr.
+         */
+        std::vector<Vertex> Vr;
+        /**
+         * @brief The vertices in S.
+         */
+        std::vector<Vertex> S;
+        /**
+         * @brief The shortest paths from r.
+         */
+        ShortestPathWorkspace<Graph> paths;
+      };
+
+      /**
+       * @brief Find the initial Vismara cycle families for a single root.
+       *
+       * The cycle families for different roots are independent and can be
+       * computed in parallel (using a separate workspace for each thread).
        *
        * @param g The graph.
+       * @param r The root vertex.
+       * @param workspace The scratch memory.
+       * @param families The output, families for r are appended.
        */
       template<typename Graph>
-      std::vector<CycleFamily<Graph>> initialCycleFamilies(const Graph &g)
+      void rootCycleFamilies(const Graph &g,
+          typename GraphTraits<Graph>::Vertex r,
+          CycleFamiliesWorkspace<Graph> &workspace,
+          std::vector<CycleFamily<Graph>> &families)
       {
         using Vertex = typename GraphTraits<Graph>::Vertex;
 
@@ -337,83 +458,97 @@ namespace ocgl {
         //                               r to y that passes only to through vertices
         //                               which precede r in the ordering pi }
 
-        std::vector<impl::CycleFamily<Graph>> families;
-
-
-        // allocate memory for Vr and S
-        std::vector<Vertex> Vr;
-        Vr.reserve(numVertices(g));
-        std::vector<Vertex> S;
-        S.reserve(numVertices(g));
-
-        // for all r in V do
-        for (auto r : getVertices(g)) {
-          // compute Vr and for all t in Vr find a shortest path P(r, t) from r to t
-          VertexPropertyMap<Graph, bool> vertexMask(g);
-          for (std::size_t i = 0; i < getVertexIndex(g, r) + 1; ++i)
-            vertexMask[getVertex(g, i)] = true;
-
-          Dijkstra<Graph> dijkstra(g, r, vertexMask);
-
-          Vr.clear();
-          for (std::size_t i = 0; i <= getVertexIndex(g, r); ++i)
-            if (dijkstra.distance(getVertex(g, i)) < dijkstra.infinity())
-              Vr.push_back(getVertex(g, i));
-
-          auto Dr = std::make_shared<impl::DirectedAdjacencyMatrix>(numVertices(g));;
+        auto &Vr = workspace.Vr;
+        auto &S = workspace.S;
+        auto &paths = workspace.paths;
+
+        auto ri = getVertexIndex(g, r);
+
+        // compute Vr and for all t in Vr find a shortest path P(r, t) from r to t
+        paths.bfs(g, r, [&g, ri] (Vertex v) {
+          return getVertexIndex(g, v) <= ri;
+        });
+
+        Vr.clear();
+        for (std::size_t i = 0; i <= ri; ++i)
+          if (paths.isReached(getVertex(g, i)))
+            Vr.push_back(getVertex(g, i));
+
+        auto Dr = std::make_shared<impl::ShortestPathDAG<Graph>>(g, Vr);
+
+        // for all y in Vr do
+        for (auto y : Vr) {
+          // S <- {}
+          S.clear();
+
+          // for all z in Vr such that z is adjacent to y
+          for (auto z : getAdjacent(g, y)) {
+            // z in Vr
+            if (!paths.isReached(z))
+              continue;
+
+            // if d(r, z) + w((z, y)) = d(r, y) then
+            if (paths.distance(z) + 1 == paths.distance(y)) {
+              // S <- S U {z}
+              S.push_back(z);
+
+            // else if d(r, z) != d(r, y) + w((z, y))
+            //     and pi(z) < pi(y)
+            //     and P(r, y) ^ P(r, z) = {r}
+            // then
+            } else if (paths.distance(z) != paths.distance(y) + 1 &&
+                       getVertexIndex(g, z) < getVertexIndex(g, y) &&
+                       impl::pathsIntersectionIsSource(paths, g, y, z)) {
+
+              // add to CI' the odd cycle C = P(r, y) + P(r, z) + (z, y)
+              auto prototype = impl::CycleFamily<Graph>::cycleFromPaths(
+                  paths.reversePath(y), paths.reversePath(z));
+
+              families.push_back(impl::CycleFamily<Graph>(g, r, y, z,
+                    prototype, Dr));
+            }
+          }
 
-          // for all y in Vr do
-          for (auto y : Vr) {
-            // S <- {}
-            S.clear();
+          // add directed edges (y, z) to Dr for all z in S
+          Dr->addPredecessors(S);
 
-            // for all z in Vr such that z is adjacent to y
-            for (auto z : getAdjacent(g, y)) {
-              if (!std::binary_search(Vr.begin(), Vr.end(), z))
+          // for any pair of vertices p, q in S such that P(r, p) ^ P(r, q) = {r} do
+          for (std::size_t j = 0; j < S.size(); ++j)
+            for (std::size_t k = j + 1; k < S.size(); ++k) {
+              const Vertex &p = S[j];
+              const Vertex &q = S[k];
+              if (!impl::pathsIntersectionIsSource(paths, g, p, q))
                 continue;
 
-              // if d(r, z) + w((z, y)) = d(r, y) then
-              if (dijkstra.distance(z) + 1 == dijkstra.distance(y)) {
-                // S <- S U {z}
-                S.push_back(z);
-
-                // add directed edge (y, z) to Dr
-                Dr->addEdge(getVertexIndex(g, y), getVertexIndex(g, z));
+              // add to CI' the even cycle C = P(r .. p) + P(r .. q) + (p, y, q)
+              auto prototype = impl::CycleFamily<Graph>::cycleFromPaths(
+                  paths.reversePath(p), y, paths.reversePath(q));
 
-              // else if d(r, z) != d(r, y) + w((z, y))
-              //     and pi(z) < pi(y)
-              //     and P(r, y) ^ P(r, z) = {r}
-              // then
-              } else if (dijkstra.distance(z) != dijkstra.distance(y) + 1 &&
-                         getVertexIndex(g, z) < getVertexIndex(g, y) &&
-                         impl::pathsIntersectionIsSource(dijkstra, g, y, z)) {
-
-                // add to CI' the odd cycle C = P(r, y) + P(r, z) + (z, y)
-                auto prototype = impl::CycleFamily<Graph>::cycleFromPaths(
-                    dijkstra.reversePath(y), dijkstra.reversePath(z));
-
-                families.push_back(impl::CycleFamily<Graph>(g, r, y, z,
-                      prototype, Dr));
-              }
+              families.push_back(impl::CycleFamily<Graph>(g, r, p, q, y,
+                    prototype, Dr));
             }
+        }
+      }
 
-            // for any pair of vertices p, q in S such that P(r, p) ^ P(r, q) = {r} do
-            for (std::size_t j = 0; j < S.size(); ++j)
-              for (std::size_t k = j + 1; k < S.size(); ++k) {
-                const Vertex &p = S[j];
-                const Vertex &q = S[k];
-                if (!impl::pathsIntersectionIsSource(dijkstra, g, p, q))
-                  continue;
+      /**
+       * @brief Find the initial Vismara cycle families.
+       *
+       * @param g The graph.
+       */
+      template<typename Graph>
+      std::vector<CycleFamily<Graph>> initialCycleFamilies(const Graph &g)
+      {
+        std::vector<impl::CycleFamily<Graph>> families;
 
-                // add to CI' the even cycle C = P(r .. p) + P(r .. q) + (p, y, q)
-                auto prototype = impl::CycleFamily<Graph>::cycleFromPaths(
-                    dijkstra.reversePath(p), y, dijkstra.reversePath(q));
+        // allocate memory for Vr, S and the shortest paths
+        CycleFamiliesWorkspace<Graph> workspace;
+        workspace.Vr.reserve(numVertices(g));
+        workspace.S.reserve(numVertices(g));
+        workspace.paths.reserve(numVertices(g));
 
-                families.push_back(impl::CycleFamily<Graph>(g, r, p, q, y,
-                      prototype, Dr));
-              }
-          }
-        }
+        // for all r in V do
+        for (auto r : getVertices(g))
+          rootCycleFamilies(g, r, workspace, families);
 
         return families;
       }
@@ -423,6 +558,12 @@ namespace ocgl {
        *
        * Families that are not relevant will be removed.
        *
+       * A family is relevant if its prototype is not a sum of smaller cycles.
+       * The families with the same size are therefore checked before their
+       * prototypes are inserted in the cycle space (inserting them one by one
+       * would also reject prototypes that are a sum of smaller and same size
+       * cycles).
+       *
        * @param g The graph.
        * @param families The initial set of cycle families.
        *
@@ -454,10 +595,10 @@ namespace ocgl {
 
           // update cycleSpace
           if (lastSize < family.prototype().size()) {
-            // add newly added relevant family prototypes to cycleSpace
+            // add newly added relevant family prototypes to cycleSpace, the
+            // basis is extended incrementally
             for (auto j : add)
-              cycleSpace.addVertexCycle(families[j].prototype(), false);
-            cycleSpace.updateMatrix();
+              cycleSpace.tryInsertVertexCycle(families[j].prototype());
             add.clear();
 
             // check if the cycle set is complete
@@ -485,102 +626,91 @@ namespace ocgl {
           families.erase(families.begin() + remove[remove.size() - i - 1]);
       }
 
-      /*
-      template<typename Graph>
-      void selectRelevantCycleFamiliesSubrange(const std::vector<CycleFamily<Graph>> &families,
-          std::size_t begin, std::size_t end, CycleSpace<Graph> &cycleSpace,
-          std::vector<unsigned char> &add, std::vector<unsigned char> &remove)
-      {
-        for (auto i = begin; i < end; ++i) {
-          if (cycleSpace.contains(families[i].prototype())) {
-            remove[i] = 1;
-          } else {
-            add[i] = 1;
-          }
-        }
-      }
-
-
+      /**
+       * @brief Select the relevant families using multiple threads.
+       *
+       * Same as selectRelevantCycleFamilies() but the families with the same
+       * cycle size are checked in parallel. The cycle space only contains
+       * smaller cycles while checking the families of the same size, so the
+       * checks are independent and the cycle space is read-only. Each thread
+       * uses its own scratch row (see CycleSpace::containsVertexCycle()).
+       *
+       * Sizes with fewer than minFamiliesPerThread families per thread are
+       * checked in the calling thread.
+       *
+       * @param g The graph.
+       * @param families The initial set of cycle families.
+       * @param numThreads The number of threads, 0 to use hardwareThreads().
+       * @param minFamiliesPerThread The minimum number of families (with the
+       *        same cycle size) per thread to check the families in parallel.
+       *
+       * @post families contains only relevant cycle families.
+       */
       template<typename Graph>
-      void selectRelevantCycleFamiliesParallel(const Graph &g, unsigned int circuitRank,
-          std::vector<CycleFamily<Graph>> &families)
+      void selectRelevantCycleFamiliesParallel(const Graph &g,
+          unsigned int circuitRank, std::vector<CycleFamily<Graph>> &families,
+          unsigned int numThreads = 0, unsigned int minFamiliesPerThread = 10)
       {
         // if there are no families, there is nothing to do..
         if (families.empty())
           return;
 
+        if (!numThreads)
+          numThreads = hardwareThreads();
+
         // sort families by cycle size
         std::sort(families.begin(), families.end());
 
-        // keep track of families that are not relevant
-        std::vector<unsigned char> remove(families.size());
-        // keep track of families that are relevant and not yet added to B
-        // (i.e. families of the current cycle size being considered)
-        std::vector<unsigned char> add(families.size());
+        // keep track of families that are relevant
+        std::vector<unsigned char> relevant(families.size());
         // the cycle space of cycles smaller than the current cycle size
         CycleSpace<Graph> cycleSpace(g, circuitRank);
+        // scratch rows for each thread
+        std::vector<std::vector<BitMatrix::Block>> scratch(numThreads);
 
         std::size_t i = 0;
         while (i < families.size()) {
           // find all families with same size in range [i, j)
           auto currentSize = families[i].prototype().size();
           auto j = i;
-          for (; j < families.size(); ++j)
-            if (families[j].prototype().size() != currentSize)
-              break;
+          while (j < families.size() && families[j].prototype().size() == currentSize)
+            ++j;
 
           // check if families with current size are relevant
-          auto N = std::thread::hardware_concurrency();
-          if (j - i < 10 * N) {
-            // run in single thread
-            selectRelevantCycleFamiliesSubrange(families, i, j,
-                cycleSpace, add, remove);
-          } else {
-            // run in multiple threads
-            std::vector<std::future<void>> futures;
-            for (auto n = 0; n < N; ++n) {
-              auto count = (j - i) / N;
-              auto begin = i + n * count;
-              auto end = (n + 1 == N) ? j : i + (n + 1) * count;
-
-              futures.push_back(std::async([&] {
-                    selectRelevantCycleFamiliesSubrange(families, begin, end,
-                        cycleSpace, add, remove);
-                    }));
-            }
+          auto check = [&] (std::size_t k, unsigned int t) {
+            relevant[i + k] = !cycleSpace.containsVertexCycle(
+                families[i + k].prototype(), scratch[t]);
+          };
 
-            for (auto &f : futures)
-              f.wait();
-          }
+          if (j - i < minFamiliesPerThread * numThreads)
+            parallelFor(j - i, 1, check);
+          else
+            parallelFor(j - i, numThreads, check);
 
           // update cycleSpace: add newly added relevant family prototypes
-          for (auto k = 0; k < families.size(); ++k)
-            if (add[k])
-              cycleSpace.add(families[k].prototype(), false);
-          cycleSpace.updateMatrix();
-          std::fill(add.begin(), add.end(), 0);
-
-          // check if the cycle set is complete
-          if (cycleSpace.isBasis()) {
-            // all remaining families are not relevant
-            while (j < families.size()) {
-              remove[j] = 1;
-              ++j;
-            }
-            break;
-          }
-
+          for (auto k = i; k < j; ++k)
+            if (relevant[k])
+              cycleSpace.tryInsertVertexCycle(families[k].prototype());
 
           // set i to next family size
           i = j;
+
+          // check if the cycle set is complete, all remaining families are
+          // not relevant
+          if (cycleSpace.isBasis())
+            break;
         }
 
         // remove all families that are not relevant
-        for (std::size_t i = 0; i < remove.size(); ++i)
-          if (remove[remove.size() - i - 1])
-            families.erase(families.begin() + remove.size() - i - 1);
+        std::size_t numRelevant = 0;
+        for (std::size_t k = 0; k < i; ++k)
+          if (relevant[k]) {
+            if (numRelevant != k)
+              families[numRelevant] = std::move(families[k]);
+            ++numRelevant;
+          }
+        families.erase(families.begin() + numRelevant, families.end());
       }
-      */
 
       /**
        * @brief Find the relevant cycles using Vismara algorithm.
@@ -600,7 +730,6 @@ namespace ocgl {
 
         // select relevant families
         impl::selectRelevantCycleFamilies(g, circuitRank, families);
-        //impl::selectRelevantCycleFamiliesParallel(g, circuitRank, families);
 
         // enumerate relevant cycles
         VertexCycleList<Graph> cycles;
@@ -667,6 +796,103 @@ namespace ocgl {
       return relevantCycles(g, cycleMembership(g));
     }
 
+    /**
+     * @brief Find the relevant cycles using multiple threads.
+     *
+     * The initial cycle families are computed in parallel for all (cyclic
+     * connected component, root vertex) pairs using a work-stealing loop (see
+     * parallelFor()). The relevant families are then selected and enumerated
+     * in parallel for each component. When there is only a single component,
+     * the families with the same cycle size are checked in parallel instead
+     * (see selectRelevantCycleFamiliesParallel()). The result is the same as
+     * relevantCycles(g, cycleMembership), including the order of the cycles.
+     *
+     * @param g The graph.
+     * @param cycleMembership The vertex and edge cycle membership.
+     * @param numThreads The number of threads, 0 to use hardwareThreads().
+     *
+     * @return The set of relevant cycles.
+     */
+    template<typename Graph>
+    VertexCycleList<Graph> relevantCyclesParallel(const Graph &g,
+        const VertexEdgePropertyMap<Graph, bool> &cycleMembership,
+        unsigned int numThreads = 0)
+    {
+      if (!numThreads)
+        numThreads = hardwareThreads();
+
+      // make a subgraph with only cyclic vertices and edges
+      auto cycleGraph = makeSubgraph(g, cycleMembership);
+      // create a subgraph for each cyclic connected components
+      auto cycleSubgraphs = connectedComponentsSubgraphs(cycleGraph);
+
+      using Sub = typename decltype(cycleSubgraphs)::value_type;
+      using Vertex = typename GraphTraits<Sub>::Vertex;
+
+      // work items: (component, root) pairs, the items for component c are
+      // in the range [offsets[c], offsets[c + 1])
+      std::vector<std::pair<std::size_t, Vertex>> items;
+      std::vector<std::size_t> offsets(1, 0);
+      for (std::size_t c = 0; c < cycleSubgraphs.size(); ++c) {
+        for (auto r : getVertices(cycleSubgraphs[c]))
+          items.emplace_back(c, r);
+        offsets.push_back(items.size());
+      }
+
+      // find initial set of cycle families for each item
+      std::vector<std::vector<impl::CycleFamily<Sub>>> itemFamilies(items.size());
+      std::vector<impl::CycleFamiliesWorkspace<Sub>> workspaces(numThreads);
+      parallelFor(items.size(), numThreads, [&] (std::size_t i, unsigned int t) {
+        impl::rootCycleFamilies(cycleSubgraphs[items[i].first],
+            items[i].second, workspaces[t], itemFamilies[i]);
+      });
+
+      // select relevant families and enumerate cycles for each component, a
+      // single component (e.g. a nanotube) uses the threads to check the
+      // families with the same size in parallel
+      unsigned int selectThreads = cycleSubgraphs.size() == 1 ? numThreads : 1;
+      std::vector<VertexCycleList<Graph>> componentCycles(cycleSubgraphs.size());
+      parallelFor(cycleSubgraphs.size(), numThreads, [&] (std::size_t c, unsigned int) {
+        auto &subg = cycleSubgraphs[c];
+
+        // merge families in root order
+        std::vector<impl::CycleFamily<Sub>> families;
+        for (std::size_t i = offsets[c]; i < offsets[c + 1]; ++i)
+          std::move(itemFamilies[i].begin(), itemFamilies[i].end(),
+              std::back_inserter(families));
+
+        impl::selectRelevantCycleFamiliesParallel(subg, circuitRank(subg, 1),
+            families, selectThreads);
+
+        for (auto &family : families)
+          family.enumerate([&] (const VertexCycle<Graph> &cycle) {
+            componentCycles[c].push_back(cycle);
+          });
+      });
+
+      // copy result
+      VertexCycleList<Graph> result;
+      for (auto &cycles : componentCycles)
+        std::copy(cycles.begin(), cycles.end(), std::back_inserter(result));
+
+      return result;
+    }
+
+    /**
+     * @brief Find the relevant cycles using multiple threads.
+     *
+     * @param g The graph.
+     * @param numThreads The number of threads, 0 to use hardwareThreads().
+     *
+     * @return The set of relevant cycles.
+     */
+    template<typename Graph>
+    VertexCycleList<Graph> relevantCyclesParallel(const Graph &g,
+        unsigned int numThreads = 0)
+    {
+      return relevantCyclesParallel(g, cycleMembership(g), numThreads);
+    }
+
   } // namespace algorithm
 
 } // namespace ocgl
@@ -0,0 +1,154 @@
+#ifndef OCGL_ALGORITHM_SHORTEST_PATH_TREE_H
+#define OCGL_ALGORITHM_SHORTEST_PATH_TREE_H
+
+#include <ocgl/Path.h>
+#include <ocgl/PropertyMap.h>
+
+#include <algorithm>
+#include <limits>
+
+/**
+ * @file ShortestPathTree.h
+ * @brief Result of a single source shortest path algorithm.
+ */
+
+namespace ocgl {
+
+  namespace algorithm {
+
+    /**
+     * @class ShortestPathTree ShortestPathTree.h <ocgl/algorithm/ShortestPathTree.h>
+     * @brief Result of a single source shortest path algorithm.
+     *
+     * This class stores the distance from the source vertex and the previous
+     * vertex on a shortest path to the source vertex for each vertex. It is
+     * the base class for the shortest path algorithms (e.g. BFSShortestPaths
+     * and Dijkstra) which fill in these maps when they are constructed.
+     */
+    template<typename Graph>
+    class ShortestPathTree
+    {
+      public:
+        /**
+         * @brief The vertex type.
+         */
+        using Vertex = typename GraphTraits<Graph>::Vertex;
+
+        /**
+         * @brief Get the source vertex.
+         */
+        Vertex source() const
+        {
+          return m_source;
+        }
+
+        /**
+         * @brief Get the infinity value that is returned by distance().
+         *
+         * @return The infinity value.
+         */
+        static unsigned int infinity()
+        {
+          return std::numeric_limits<unsigned int>::max();
+        }
+
+        /**
+         * @brief Get the distance between source and target vertices.
+         *
+         * The distance is the number of bonds (or the sum of the edge weights)
+         * between the source and target vertices. If there is no path, the
+         * infinity() value is returned.
+         *
+         * @param target the target vertex.
+         */
+        unsigned int distance(Vertex target) const
+        {
+          return m_dist[target];
+        }
+
+        /**
+         * @brief Reconstruct the path between source and target vertices.
+         *
+         * The path includes the source and target vertices
+         * (i.e. [source, ..., target]).
+         *
+         * @param target the target vertex.
+         */
+        VertexPath<Graph> path(Vertex target) const
+        {
+          VertexPath<Graph> S = reversePath(target);
+          std::reverse(S.begin(), S.end());
+          return S;
+        }
+
+        /**
+         * @brief Reconstruct the reverse path between target and source vertices.
+         *
+         * The path includes the source and target vertices
+         * (i.e. [target, ..., source]).
+         *
+         * @param target the target vertex.
+         */
+        VertexPath<Graph> reversePath(Vertex target) const
+        {
+          VertexPath<Graph> S;
+          Vertex u = target;
+
+          // reconstruct the path
+          while (isValidVertex(m_graph, m_prev[u])) {
+            S.push_back(u);
+            u = m_prev[u];
+          }
+
+          S.push_back(m_source);
+
+          return S;
+        }
+
+        /**
+         * @brief Get the map with previous vertices.
+         *
+         * This map gives, for each vertex, the previous vertex for the shortest
+         * path to source.
+         */
+        const VertexPropertyMap<Graph, Vertex>& prev() const
+        {
+          return m_prev;
+        }
+
+      protected:
+        /**
+         * @brief Constructor.
+         *
+         * @param g The graph.
+         * @param source The source vertex.
+         */
+        ShortestPathTree(const Graph &g, Vertex source)
+          : m_graph(g), m_source(source), m_dist(g, infinity()),
+            m_prev(g, nullVertex<Graph>())
+        {
+        }
+
+        /**
+         * @brief The graph.
+         */
+        const Graph &m_graph;
+        /**
+         * @brief The source vertex.
+         */
+        Vertex m_source;
+        /**
+         * @brief The distance from source for each vertex.
+         */
+        VertexPropertyMap<Graph, unsigned int> m_dist;
+        /**
+         * @brief The previous vertex on the shortest path to source.
+         */
+        VertexPropertyMap<Graph, Vertex> m_prev;
+    };
+
+  } // namespace algorithm
+
+} // namespace ocgl
+
+#endif // OCGL_ALGORITHM_SHORTEST_PATH_TREE_H
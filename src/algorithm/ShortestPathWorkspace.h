@@ -0,0 +1,302 @@
+#ifndef OCGL_ALGORITHM_SHORTEST_PATH_WORKSPACE_H
+#define OCGL_ALGORITHM_SHORTEST_PATH_WORKSPACE_H
+
+#include <ocgl/algorithm/StampedMarkers.h>
+#include <ocgl/Path.h>
+#include <ocgl/PropertyMap.h>
+
+#include <algorithm>
+#include <vector>
+#include <limits>
+
+/**
+ * @file ShortestPathWorkspace.h
+ * @brief Reusable buffers for running many single source shortest path searches.
+ */
+
+namespace ocgl {
+
+  namespace algorithm {
+
+    /**
+     * @class ShortestPathWorkspace ShortestPathWorkspace.h <ocgl/algorithm/ShortestPathWorkspace.h>
+     * @brief Reusable buffers for running many single source shortest path searches.
+     *
+     * The BFSShortestPaths and Dijkstra classes allocate their distance and
+     * previous vertex maps (and a queue) for every source vertex. Algorithms
+     * that need the shortest paths from many sources (e.g. relevant cycles)
+     * can use a single ShortestPathWorkspace instead.
+     *
+     * The buffers are only grown, never shrunk, so the workspace can be reused
+     * for other graphs of similar size. Instead of resetting all distances to
+     * infinity before each search, every vertex has a stamp that records the
+     * search (epoch) in which it was last reached. A vertex that was not
+     * reached in the current search has an infinite distance. Starting a new
+     * search is therefore O(1) and a search is O(touched vertices + edges).
+     *
+     * The results of a search are valid until the next search is started.
+     *
+     * @code
+     * ShortestPathWorkspace<Graph> paths;
+     * for (auto r : getVertices(g)) {
+     *   paths.bfs(g, r);
+     *   for (auto v : paths.reached())
+     *     std::cout << paths.distance(v) << std::endl;
+     * }
+     * @endcode
+     */
+    template<typename Graph>
+    class ShortestPathWorkspace
+    {
+      public:
+        /**
+         * @brief The vertex type.
+         */
+        using Vertex = typename GraphTraits<Graph>::Vertex;
+
+        /**
+         * @brief Constructor.
+         */
+        ShortestPathWorkspace() : m_graph(nullptr)
+        {
+        }
+
+        /**
+         * @brief Constructor.
+         *
+         * @param numVertices The number of vertices to allocate memory for.
+         */
+        explicit ShortestPathWorkspace(unsigned int numVertices)
+          : m_graph(nullptr)
+        {
+          reserve(numVertices);
+        }
+
+        /**
+         * @brief Make sure the buffers can hold numVertices vertices.
+         *
+         * @param numVertices The number of vertices.
+         */
+        void reserve(unsigned int numVertices)
+        {
+          if (numVertices <= m_reachedMarkers.size())
+            return;
+
+          m_dist.resize(numVertices);
+          m_prev.resize(numVertices);
+          m_reachedMarkers.resize(numVertices);
+          m_reached.reserve(numVertices);
+        }
+
+        /**
+         * @brief Get the infinity value that is returned by distance().
+         */
+        static unsigned int infinity()
+        {
+          return std::numeric_limits<unsigned int>::max();
+        }
+
+        /**
+         * @brief Breadth-first search shortest paths from source.
+         *
+         * @param g The graph.
+         * @param source The source vertex.
+         */
+        void bfs(const Graph &g, Vertex source)
+        {
+          bfs(g, source, [] (Vertex) { return true; });
+        }
+
+        /**
+         * @brief Breadth-first search shortest paths from source.
+         *
+         * Only the vertices in the mask will be considered.
+         *
+         * @param g The graph.
+         * @param source The source vertex.
+         * @param vertexMask The vertex mask.
+         *
+         * @pre vertexMask[source]
+         */
+        void bfs(const Graph &g, Vertex source,
+            const VertexPropertyMap<Graph, bool> &vertexMask)
+        {
+          bfs(g, source, [&vertexMask] (Vertex v) { return vertexMask[v]; });
+        }
+
+        /**
+         * @brief Breadth-first search shortest paths from source.
+         *
+         * Only the vertices for which the filter returns true will be
+         * considered. Unlike a vertex mask, a filter does not need memory
+         * (e.g. [&] (Vertex v) { return getVertexIndex(g, v) <= r; }).
+         *
+         * @param g The graph.
+         * @param source The source vertex.
+         * @param filter Function object with signature bool(Vertex).
+         *
+         * @pre filter(source)
+         */
+        template<typename VertexFilter>
+        void bfs(const Graph &g, Vertex source, VertexFilter filter)
+        {
+          start(g, source);
+
+          // m_reached is also the queue, head is used to get the next vertex
+          for (std::size_t head = 0; head < m_reached.size(); ++head) {
+            Vertex u = m_reached[head];
+            unsigned int alt = m_dist[getVertexIndex(g, u)] + 1;
+
+            for (auto v : getAdjacent(g, u)) {
+              auto vi = getVertexIndex(g, v);
+
+              // vertices are visited in order of distance, the first path
+              // found is a shortest path
+              if (m_reachedMarkers.isMarked(vi) || !filter(v))
+                continue;
+
+              m_reachedMarkers.mark(vi);
+              m_dist[vi] = alt;
+              m_prev[vi] = u;
+              m_reached.push_back(v);
+            }
+          }
+        }
+
+        /**
+         * @brief Get the source vertex of the last search.
+         */
+        Vertex source() const
+        {
+          return m_reached.front();
+        }
+
+        /**
+         * @brief Get the vertices reached by the last search.
+         *
+         * The vertices are in order of increasing distance from source.
+         */
+        const std::vector<Vertex>& reached() const
+        {
+          return m_reached;
+        }
+
+        /**
+         * @brief Check if a vertex was reached by the last search.
+         */
+        bool isReached(Vertex v) const
+        {
+          return m_reachedMarkers.isMarked(getVertexIndex(*m_graph, v));
+        }
+
+        /**
+         * @brief Get the distance between source and target vertices.
+         *
+         * If there is no path, the infinity() value is returned.
+         *
+         * @param target the target vertex.
+         */
+        unsigned int distance(Vertex target) const
+        {
+          auto i = getVertexIndex(*m_graph, target);
+          return m_reachedMarkers.isMarked(i) ? m_dist[i] : infinity();
+        }
+
+        /**
+         * @brief Get the previous vertex on the shortest path to source.
+         *
+         * @param target the target vertex.
+         *
+         * @return The previous vertex or a null vertex if target is the source
+         *         or was not reached.
+         */
+        Vertex prev(Vertex target) const
+        {
+          auto i = getVertexIndex(*m_graph, target);
+          return m_reachedMarkers.isMarked(i) ? m_prev[i] : nullVertex<Graph>();
+        }
+
+        /**
+         * @brief Reconstruct the path between source and target vertices.
+         *
+         * The path includes the source and target vertices
+         * (i.e. [source, ..., target]).
+         *
+         * @param target the target vertex.
+         *
+         * @pre isReached(target)
+         */
+        VertexPath<Graph> path(Vertex target) const
+        {
+          VertexPath<Graph> S = reversePath(target);
+          std::reverse(S.begin(), S.end());
+          return S;
+        }
+
+        /**
+         * @brief Reconstruct the reverse path between target and source vertices.
+         *
+         * The path includes the source and target vertices
+         * (i.e. [target, ..., source]).
+         *
+         * @param target the target vertex.
+         *
+         * @pre isReached(target)
+         */
+        VertexPath<Graph> reversePath(Vertex target) const
+        {
+          VertexPath<Graph> S;
+          S.reserve(distance(target) + 1);
+
+          for (Vertex u = target; isValidVertex(*m_graph, u); u = prev(u))
+            S.push_back(u);
+
+          return S;
+        }
+
+      private:
+        /**
+         * @brief Start a new search.
+         */
+        void start(const Graph &g, Vertex source)
+        {
+          m_graph = &g;
+          reserve(numVertices(g));
+          m_reachedMarkers.clear();
+
+          auto si = getVertexIndex(g, source);
+          m_reachedMarkers.mark(si);
+          m_dist[si] = 0;
+          m_prev[si] = nullVertex<Graph>();
+
+          m_reached.clear();
+          m_reached.push_back(source);
+        }
+
+        /**
+         * @brief The graph of the last search.
+         */
+        const Graph *m_graph;
+        /**
+         * @brief The distance from source (valid if the vertex is reached).
+         */
+        std::vector<unsigned int> m_dist;
+        /**
+         * @brief The previous vertex (valid if the vertex is reached).
+         */
+        std::vector<Vertex> m_prev;
+        /**
+         * @brief The vertices reached in the last search.
+         */
+        impl::StampedMarkers m_reachedMarkers;
+        /**
+         * @brief The reached vertices in BFS order (also used as queue).
+         */
+        std::vector<Vertex> m_reached;
+    };
+
+  } // namespace algorithm
+
+} // namespace ocgl
+
+#endif // OCGL_ALGORITHM_SHORTEST_PATH_WORKSPACE_H
@@ -0,0 +1,115 @@
+#ifndef OCGL_ALGORITHM_STAMPED_MARKERS_H
+#define OCGL_ALGORITHM_STAMPED_MARKERS_H
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+/**
+ * @file StampedMarkers.h
+ * @brief Markers that can be cleared in constant time.
+ */
+
+namespace ocgl {
+
+  namespace algorithm {
+
+    namespace impl {
+
+      /**
+       * @class StampedMarkers StampedMarkers.h <ocgl/algorithm/StampedMarkers.h>
+       * @brief Markers for the indices [0, size()) that can be cleared in
+       *        constant time.
+       *
+       * Every index has a stamp that records the epoch in which it was last
+       * marked, an index is marked if its stamp is the current epoch.
+       * Clearing the markers starts a new epoch, the stamps are only reset
+       * when the epoch wraps around. This is used by the workspaces to
+       * start a new traversal or search in O(1).
+       */
+      class StampedMarkers
+      {
+        public:
+          /**
+           * @brief Constructor.
+           *
+           * clear() has to be called before the markers are used.
+           *
+           * @param epoch The initial epoch (e.g. to test the wraparound).
+           */
+          explicit StampedMarkers(unsigned int epoch = 0) : m_epoch(epoch)
+          {
+          }
+
+          /**
+           * @brief Get the number of indices.
+           */
+          std::size_t size() const
+          {
+            return m_stamps.size();
+          }
+
+          /**
+           * @brief Make sure there are at least size indices. The new indices
+           *        are not marked.
+           */
+          void resize(std::size_t size)
+          {
+            if (size > m_stamps.size())
+              m_stamps.resize(size, 0);
+          }
+
+          /**
+           * @brief Unmark all indices.
+           */
+          void clear()
+          {
+            // when the epoch wraps around, old stamps could become valid again
+            if (++m_epoch == 0) {
+              std::fill(m_stamps.begin(), m_stamps.end(), 0);
+              m_epoch = 1;
+            }
+          }
+
+          /**
+           * @brief Check if an index is marked.
+           */
+          bool isMarked(std::size_t i) const
+          {
+            return m_stamps[i] == m_epoch;
+          }
+
+          /**
+           * @brief Mark an index.
+           */
+          void mark(std::size_t i)
+          {
+            m_stamps[i] = m_epoch;
+          }
+
+          /**
+           * @brief Get the current epoch.
+           */
+          unsigned int epoch() const
+          {
+            return m_epoch;
+          }
+
+        private:
+          /**
+           * @brief The epoch in which each index was last marked.
+           */
+          std::vector<unsigned int> m_stamps;
+          /**
+           * @brief The current epoch.
+           */
+          unsigned int m_epoch;
+      };
+
+    } // namespace impl
+
+  } // namespace algorithm
+
+} // namespace ocgl
+
+#endif // OCGL_ALGORITHM_STAMPED_MARKERS_H
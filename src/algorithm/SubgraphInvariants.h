@@ -0,0 +1,311 @@
+#ifndef OCGL_ALGORITHM_SUBGRAPH_INVARIANTS_H
+#define OCGL_ALGORITHM_SUBGRAPH_INVARIANTS_H
+
+#include <ocgl/algorithm/CycleMembership.h>
+
+#include <vector>
+
+/**
+ * @file SubgraphInvariants.h
+ * @brief Graph invariants to screen subgraph isomorphism searches.
+ */
+
+namespace ocgl {
+
+  namespace algorithm {
+
+    /**
+     * @class SubgraphInvariants SubgraphInvariants.h <ocgl/algorithm/SubgraphInvariants.h>
+     * @brief Graph invariants to screen subgraph isomorphism searches.
+     *
+     * A query can only be a subgraph of a target if the target has at least
+     * as many vertices and edges as the query. Since a vertex with degree d
+     * can only be mapped to a vertex with degree >= d, the target also needs
+     * at least as many vertices with degree >= d as the query (for every d).
+     * This is the same as comparing the sorted degree sequences.
+     *
+     * Optionally, the number of cyclic vertices and edges (computeCycles())
+     * and a vertex label histogram (computeLabels()) can be added. A cycle in
+     * the query is mapped to a cycle in the target, so the target needs at
+     * least as many cyclic vertices and edges. The label histogram is only
+     * valid when the vertex matcher requires equal labels.
+     *
+     * The invariants are computed in O(|V| + |E|) and compared in
+     * O(max degree + number of labels), which is a lot cheaper than starting
+     * a search that can not succeed.
+     */
+    class SubgraphInvariants
+    {
+      public:
+        /**
+         * @brief Constructor for an empty graph.
+         */
+        SubgraphInvariants() : m_numVertices(0), m_numEdges(0),
+            m_numCyclicVertices(0), m_numCyclicEdges(0), m_hasCycles(false),
+            m_hasLabels(false)
+        {
+        }
+
+        /**
+         * @brief Compute the invariants for a graph.
+         *
+         * @param g The graph.
+         */
+        template<typename Graph>
+        explicit SubgraphInvariants(const Graph &g)
+        {
+          compute(g);
+        }
+
+        /**
+         * @brief Compute the counts and degree histogram for a graph.
+         *
+         * The memory is reused, so the same object can be used for many
+         * graphs. The cycle and label invariants are cleared.
+         *
+         * @param g The graph.
+         */
+        template<typename Graph>
+        void compute(const Graph &g)
+        {
+          m_numVertices = ocgl::numVertices(g);
+          m_numEdges = ocgl::numEdges(g);
+          m_numCyclicVertices = 0;
+          m_numCyclicEdges = 0;
+          m_hasCycles = false;
+          m_hasLabels = false;
+
+          // histogram of degrees
+          m_degreeCounts.clear();
+          for (auto v : getVertices(g)) {
+            auto degree = getDegree(g, v);
+            if (degree >= m_degreeCounts.size())
+              m_degreeCounts.resize(degree + 1, 0);
+            ++m_degreeCounts[degree];
+          }
+
+          // number of vertices with degree >= d
+          for (std::size_t d = m_degreeCounts.size(); d > 1; --d)
+            m_degreeCounts[d - 2] += m_degreeCounts[d - 1];
+        }
+
+        /**
+         * @brief Compute the number of cyclic vertices and edges.
+         *
+         * @param g The graph.
+         */
+        template<typename Graph>
+        void computeCycles(const Graph &g)
+        {
+          computeCycles(g, cycleMembership(g));
+        }
+
+        /**
+         * @brief Compute the number of cyclic vertices and edges from a
+         *        precomputed cycle membership.
+         *
+         * @param g The graph.
+         * @param cyclic The cycle membership (see cycleMembership()).
+         */
+        template<typename Graph>
+        void computeCycles(const Graph &g,
+            const VertexEdgePropertyMap<Graph, bool> &cyclic)
+        {
+          m_numCyclicVertices = 0;
+          for (auto v : getVertices(g))
+            if (cyclic.vertices[v])
+              ++m_numCyclicVertices;
+
+          m_numCyclicEdges = 0;
+          for (auto e : getEdges(g))
+            if (cyclic.edges[e])
+              ++m_numCyclicEdges;
+
+          m_hasCycles = true;
+        }
+
+        /**
+         * @brief Compute the vertex label histogram.
+         *
+         * @param g The graph.
+         * @param label Function object with signature unsigned int(Vertex)
+         *        (e.g. the element of an atom).
+         */
+        template<typename Graph, typename VertexLabel>
+        void computeLabels(const Graph &g, VertexLabel label)
+        {
+          m_labelCounts.clear();
+          for (auto v : getVertices(g)) {
+            unsigned int l = label(v);
+            if (l >= m_labelCounts.size())
+              m_labelCounts.resize(l + 1, 0);
+            ++m_labelCounts[l];
+          }
+
+          m_hasLabels = true;
+        }
+
+        /**
+         * @brief Get the number of vertices.
+         */
+        unsigned int numVertices() const
+        {
+          return m_numVertices;
+        }
+
+        /**
+         * @brief Get the number of edges.
+         */
+        unsigned int numEdges() const
+        {
+          return m_numEdges;
+        }
+
+        /**
+         * @brief Get the number of vertices with degree >= d.
+         */
+        unsigned int numVerticesWithMinDegree(unsigned int d) const
+        {
+          return d < m_degreeCounts.size() ? m_degreeCounts[d] : 0;
+        }
+
+        /**
+         * @brief Check if computeCycles() was called.
+         */
+        bool hasCycles() const
+        {
+          return m_hasCycles;
+        }
+
+        /**
+         * @brief Get the number of cyclic vertices.
+         */
+        unsigned int numCyclicVertices() const
+        {
+          return m_numCyclicVertices;
+        }
+
+        /**
+         * @brief Get the number of cyclic edges.
+         */
+        unsigned int numCyclicEdges() const
+        {
+          return m_numCyclicEdges;
+        }
+
+        /**
+         * @brief Check if computeLabels() was called.
+         */
+        bool hasLabels() const
+        {
+          return m_hasLabels;
+        }
+
+        /**
+         * @brief Get the number of vertices with a label.
+         */
+        unsigned int numVerticesWithLabel(unsigned int label) const
+        {
+          return label < m_labelCounts.size() ? m_labelCounts[label] : 0;
+        }
+
+        /**
+         * @brief Check if the degree sequence of the query fits in this graph.
+         */
+        bool mayContainDegrees(const SubgraphInvariants &query) const
+        {
+          if (query.m_degreeCounts.size() > m_degreeCounts.size())
+            return false;
+
+          for (std::size_t d = 0; d < query.m_degreeCounts.size(); ++d)
+            if (query.m_degreeCounts[d] > m_degreeCounts[d])
+              return false;
+
+          return true;
+        }
+
+        /**
+         * @brief Check if the label histogram of the query fits in this graph.
+         *
+         * Returns true if the labels were not computed for both graphs.
+         */
+        bool mayContainLabels(const SubgraphInvariants &query) const
+        {
+          if (!m_hasLabels || !query.m_hasLabels)
+            return true;
+
+          for (std::size_t l = 0; l < query.m_labelCounts.size(); ++l)
+            if (query.m_labelCounts[l] > numVerticesWithLabel(l))
+              return false;
+
+          return true;
+        }
+
+        /**
+         * @brief Check if the cyclic vertex and edge counts of the query fit
+         *        in this graph.
+         *
+         * Returns true if the cycles were not computed for both graphs.
+         */
+        bool mayContainCycles(const SubgraphInvariants &query) const
+        {
+          if (!m_hasCycles || !query.m_hasCycles)
+            return true;
+
+          return query.m_numCyclicVertices <= m_numCyclicVertices &&
+            query.m_numCyclicEdges <= m_numCyclicEdges;
+        }
+
+        /**
+         * @brief Check if this graph may contain the query as subgraph.
+         *
+         * If false is returned, the query is not a subgraph. If true is
+         * returned, a search is needed.
+         */
+        bool mayContain(const SubgraphInvariants &query) const
+        {
+          return query.m_numVertices <= m_numVertices &&
+            query.m_numEdges <= m_numEdges && mayContainDegrees(query) &&
+            mayContainCycles(query) && mayContainLabels(query);
+        }
+
+      private:
+        /**
+         * @brief The number of vertices.
+         */
+        unsigned int m_numVertices;
+        /**
+         * @brief The number of edges.
+         */
+        unsigned int m_numEdges;
+        /**
+         * @brief The number of vertices with degree >= d (index d).
+         */
+        std::vector<unsigned int> m_degreeCounts;
+        /**
+         * @brief The number of cyclic vertices.
+         */
+        unsigned int m_numCyclicVertices;
+        /**
+         * @brief The number of cyclic edges.
+         */
+        unsigned int m_numCyclicEdges;
+        /**
+         * @brief True if computeCycles() was called.
+         */
+        bool m_hasCycles;
+        /**
+         * @brief The number of vertices for each label.
+         */
+        std::vector<unsigned int> m_labelCounts;
+        /**
+         * @brief True if computeLabels() was called.
+         */
+        bool m_hasLabels;
+    };
+
+  } // namespace algorithm
+
+} // namespace ocgl
+
+#endif // OCGL_ALGORITHM_SUBGRAPH_INVARIANTS_H
@@ -0,0 +1,244 @@
+#ifndef OCGL_ALGORITHM_SUBGRAPH_SCREEN_H
+#define OCGL_ALGORITHM_SUBGRAPH_SCREEN_H
+
+#include <ocgl/algorithm/SubgraphInvariants.h>
+
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+/**
+ * @file SubgraphScreen.h
+ * @brief Pre-filter for subgraph isomorphism searches.
+ */
+
+namespace ocgl {
+
+  namespace algorithm {
+
+    /**
+     * @class SubgraphScreen SubgraphScreen.h <ocgl/algorithm/SubgraphScreen.h>
+     * @brief Pre-filter for subgraph isomorphism searches.
+     *
+     * The screen compares the SubgraphInvariants of a target and a query
+     * using a sequence of tests. The tests are ordered from cheap to
+     * expensive and the first failing test rejects the pair. Each test can be
+     * disabled and custom tests can be added. The screen counts how often
+     * each test rejects a pair, which shows if a test is worth its cost.
+     *
+     * The cycle and label tests only reject pairs if the invariants were
+     * computed for both graphs (see SubgraphInvariants::computeCycles() and
+     * SubgraphInvariants::computeLabels()).
+     *
+     * The cycle counts require a DFS, so they are usually only computed for
+     * targets that pass the cheaper tests. In that case, mayContain() is
+     * called before the target's cycles are computed (the cycle test always
+     * passes) and mayContainCycles() after.
+     *
+     * The counters are not thread safe, use one screen per thread and merge
+     * the counters with mergeCounters().
+     */
+    class SubgraphScreen
+    {
+      public:
+        /**
+         * @brief The built-in tests.
+         */
+        enum Test
+        {
+          /**
+           * @brief The target has at least as many vertices.
+           */
+          VertexCount,
+          /**
+           * @brief The target has at least as many edges.
+           */
+          EdgeCount,
+          /**
+           * @brief The target has at least as many vertices with degree >= d
+           *        for every d.
+           */
+          DegreeSequence,
+          /**
+           * @brief The target has at least as many cyclic vertices and edges.
+           */
+          CycleCount,
+          /**
+           * @brief The target has at least as many vertices with each label.
+           */
+          LabelHistogram,
+          /**
+           * @brief The custom tests added with addTest().
+           */
+          Custom,
+          /**
+           * @brief The number of tests.
+           */
+          NumTests
+        };
+
+        /**
+         * @brief A custom test, called as test(target, query). Returns false
+         *        if the target can not contain the query.
+         */
+        using CustomTest = std::function<bool(const SubgraphInvariants&,
+            const SubgraphInvariants&)>;
+
+        /**
+         * @brief Constructor, all tests are enabled.
+         */
+        SubgraphScreen()
+        {
+          m_enabled.fill(true);
+          resetCounters();
+        }
+
+        /**
+         * @brief Enable or disable a test.
+         */
+        void setEnabled(Test test, bool enabled)
+        {
+          m_enabled[test] = enabled;
+        }
+
+        /**
+         * @brief Check if a test is enabled.
+         */
+        bool isEnabled(Test test) const
+        {
+          return m_enabled[test];
+        }
+
+        /**
+         * @brief Add a custom test. The custom tests are run after the
+         *        built-in tests.
+         */
+        void addTest(const CustomTest &test)
+        {
+          m_customTests.push_back(test);
+        }
+
+        /**
+         * @brief Check if the target may contain the query as subgraph.
+         *
+         * If false is returned, the query is not a subgraph and the test that
+         * rejected the pair is counted.
+         */
+        bool mayContain(const SubgraphInvariants &target,
+            const SubgraphInvariants &query)
+        {
+          ++m_numTested;
+
+          if (m_enabled[VertexCount] &&
+              query.numVertices() > target.numVertices())
+            return reject(VertexCount);
+
+          if (m_enabled[EdgeCount] && query.numEdges() > target.numEdges())
+            return reject(EdgeCount);
+
+          if (m_enabled[DegreeSequence] && !target.mayContainDegrees(query))
+            return reject(DegreeSequence);
+
+          if (m_enabled[CycleCount] && !target.mayContainCycles(query))
+            return reject(CycleCount);
+
+          if (m_enabled[LabelHistogram] && !target.mayContainLabels(query))
+            return reject(LabelHistogram);
+
+          if (m_enabled[Custom])
+            for (const auto &test : m_customTests)
+              if (!test(target, query))
+                return reject(Custom);
+
+          return true;
+        }
+
+        /**
+         * @brief Run only the cycle test.
+         *
+         * This is used after mayContain() passed and the target's cycles
+         * were computed, the pair is not counted as tested again.
+         */
+        bool mayContainCycles(const SubgraphInvariants &target,
+            const SubgraphInvariants &query)
+        {
+          if (m_enabled[CycleCount] && !target.mayContainCycles(query))
+            return reject(CycleCount);
+
+          return true;
+        }
+
+        /**
+         * @brief Get the number of pairs rejected by a test.
+         */
+        std::size_t numRejected(Test test) const
+        {
+          return m_numRejected[test];
+        }
+
+        /**
+         * @brief Get the number of pairs rejected by any test.
+         */
+        std::size_t numRejected() const
+        {
+          std::size_t n = 0;
+          for (auto count : m_numRejected)
+            n += count;
+          return n;
+        }
+
+        /**
+         * @brief Get the number of tested pairs.
+         */
+        std::size_t numTested() const
+        {
+          return m_numTested;
+        }
+
+        /**
+         * @brief Get the number of pairs that passed all tests.
+         */
+        std::size_t numPassed() const
+        {
+          return m_numTested - numRejected();
+        }
+
+        /**
+         * @brief Set all counters to 0.
+         */
+        void resetCounters()
+        {
+          m_numRejected.fill(0);
+          m_numTested = 0;
+        }
+
+        /**
+         * @brief Add the counters of another screen (e.g. the screen used by
+         *        another thread).
+         */
+        void mergeCounters(const SubgraphScreen &other)
+        {
+          for (std::size_t i = 0; i < m_numRejected.size(); ++i)
+            m_numRejected[i] += other.m_numRejected[i];
+          m_numTested += other.m_numTested;
+        }
+
+      private:
+        bool reject(Test test)
+        {
+          ++m_numRejected[test];
+          return false;
+        }
+
+        std::array<bool, NumTests> m_enabled;
+        std::vector<CustomTest> m_customTests;
+        std::array<std::size_t, NumTests> m_numRejected;
+        std::size_t m_numTested;
+    };
+
+  } // namespace algorithm
+
+} // namespace ocgl
+
+#endif // OCGL_ALGORITHM_SUBGRAPH_SCREEN_H
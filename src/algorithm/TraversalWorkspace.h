@@ -0,0 +1,201 @@
+#ifndef OCGL_ALGORITHM_TRAVERSAL_WORKSPACE_H
+#define OCGL_ALGORITHM_TRAVERSAL_WORKSPACE_H
+
+#include <ocgl/algorithm/StampedMarkers.h>
+#include <ocgl/GraphTraits.h>
+
+#include <vector>
+
+/**
+ * @file TraversalWorkspace.h
+ * @brief Reusable buffers for graph traversals.
+ */
+
+namespace ocgl {
+
+  namespace algorithm {
+
+    namespace impl {
+
+      /**
+       * @brief A vertex on the DFS stack.
+       */
+      template<typename Graph>
+      struct DFSFrame
+      {
+        using Vertex = typename GraphTraits<Graph>::Vertex;
+        using Edge = typename GraphTraits<Graph>::Edge;
+        using IncidentIter = typename GraphTraits<Graph>::IncidentIter;
+
+        /**
+         * @brief The vertex.
+         */
+        Vertex vertex;
+        /**
+         * @brief The tree edge to the vertex (not valid for the root).
+         */
+        Edge edge;
+        /**
+         * @brief The next incident edge to consider.
+         */
+        IncidentIter next;
+        /**
+         * @brief The end of the incident edges.
+         */
+        IncidentIter end;
+      };
+
+    } // namespace impl
+
+    /**
+     * @class TraversalWorkspace TraversalWorkspace.h <ocgl/algorithm/TraversalWorkspace.h>
+     * @brief Reusable buffers for graph traversals.
+     *
+     * A depth-first or breadth-first search needs to mark the visited
+     * vertices and edges, and a stack or queue. Algorithms that run many
+     * traversals (e.g. cycleMembership(), connectedComponents() and
+     * circuitRank() for millions of molecules) can pass a single workspace
+     * to avoid allocating these buffers for each traversal.
+     *
+     * Instead of clearing the visited markers before each traversal, every
+     * vertex and edge has a stamp that records the traversal (epoch) in
+     * which it was last visited. Starting a new traversal is therefore O(1).
+     * The buffers are only grown, never shrunk, so the workspace can be
+     * reused for graphs of different sizes.
+     *
+     * @code
+     * TraversalWorkspace<Graph> workspace;
+     * for (const auto &molecule : molecules) {
+     *   auto cyclic = cycleMembership(molecule, workspace);
+     *   auto rank = circuitRank(molecule, workspace);
+     *   ...
+     * }
+     * @endcode
+     *
+     * A workspace can only be used by one traversal at a time.
+     */
+    template<typename Graph>
+    class TraversalWorkspace
+    {
+      public:
+        /**
+         * @brief The vertex type.
+         */
+        using Vertex = typename GraphTraits<Graph>::Vertex;
+        /**
+         * @brief The edge type.
+         */
+        using Edge = typename GraphTraits<Graph>::Edge;
+
+        /**
+         * @brief Constructor.
+         */
+        TraversalWorkspace() : m_graph(nullptr)
+        {
+        }
+
+        /**
+         * @brief Make sure the buffers can hold numVertices vertices and
+         *        numEdges edges.
+         */
+        void reserve(unsigned int numVertices, unsigned int numEdges)
+        {
+          if (numVertices > m_visitedVertices.size()) {
+            m_visitedVertices.resize(numVertices);
+            m_queue.reserve(numVertices);
+          }
+          m_visitedEdges.resize(numEdges);
+        }
+
+        /**
+         * @brief Start a new traversal (all vertices and edges unvisited).
+         *
+         * @param g The graph.
+         */
+        void start(const Graph &g)
+        {
+          m_graph = &g;
+          reserve(numVertices(g), numEdges(g));
+          m_visitedVertices.clear();
+          m_visitedEdges.clear();
+
+          m_stack.clear();
+          m_queue.clear();
+        }
+
+        /**
+         * @brief Check if a vertex was visited in the current traversal.
+         */
+        bool isVertexVisited(Vertex v) const
+        {
+          return m_visitedVertices.isMarked(getVertexIndex(*m_graph, v));
+        }
+
+        /**
+         * @brief Mark a vertex as visited.
+         */
+        void visitVertex(Vertex v)
+        {
+          m_visitedVertices.mark(getVertexIndex(*m_graph, v));
+        }
+
+        /**
+         * @brief Check if an edge was visited in the current traversal.
+         */
+        bool isEdgeVisited(Edge e) const
+        {
+          return m_visitedEdges.isMarked(getEdgeIndex(*m_graph, e));
+        }
+
+        /**
+         * @brief Mark an edge as visited.
+         */
+        void visitEdge(Edge e)
+        {
+          m_visitedEdges.mark(getEdgeIndex(*m_graph, e));
+        }
+
+        /**
+         * @brief Get the DFS stack.
+         */
+        std::vector<impl::DFSFrame<Graph>>& stack()
+        {
+          return m_stack;
+        }
+
+        /**
+         * @brief Get the BFS queue.
+         */
+        std::vector<Vertex>& queue()
+        {
+          return m_queue;
+        }
+
+      private:
+        /**
+         * @brief The graph of the current traversal.
+         */
+        const Graph *m_graph;
+        /**
+         * @brief The vertices visited in the current traversal.
+         */
+        impl::StampedMarkers m_visitedVertices;
+        /**
+         * @brief The edges visited in the current traversal.
+         */
+        impl::StampedMarkers m_visitedEdges;
+        /**
+         * @brief The DFS stack.
+         */
+        std::vector<impl::DFSFrame<Graph>> m_stack;
+        /**
+         * @brief The BFS queue.
+         */
+        std::vector<Vertex> m_queue;
+    };
+
+  } // namespace algorithm
+
+} // namespace ocgl
+
+#endif // OCGL_ALGORITHM_TRAVERSAL_WORKSPACE_H
@@ -2,7 +2,9 @@
 #define OCGL_ALGORITHM_VF2STATE_H
 
 #include <ocgl/PropertyMap.h>
-#include <functional>
+#include <ocgl/algorithm/MatchPlan.h>
+#include <ocgl/algorithm/CandidateDomains.h>
+#include <algorithm>
 #include <vector>
 #include <limits>
 #include <iostream>
@@ -11,9 +13,78 @@ namespace ocgl {
 
   namespace algorithm {
 
+    /**
+     * @class MappingView VF2State.h <ocgl/algorithm/VF2State.h>
+     * @brief Read-only view of a query to graph vertex mapping.
+     *
+     * The view refers to the mapping that is stored in the search state, so
+     * it does not allocate memory. It is only valid inside the visitor it was
+     * passed to, use toPropertyMap() to keep a copy.
+     */
+    template<typename Query, typename Graph>
+    class MappingView
+    {
+      public:
+        /**
+         * @brief The query vertex type.
+         */
+        using QueryVertex = typename GraphTraits<Query>::Vertex;
+        /**
+         * @brief The graph vertex type.
+         */
+        using GraphVertex = typename GraphTraits<Graph>::Vertex;
+
+        /**
+         * @brief Constructor.
+         *
+         * @param query The query graph.
+         * @param graph The queried graph.
+         * @param queryMap The graph vertex index for each query vertex index.
+         */
+        MappingView(const Query &query, const Graph &graph,
+            const std::vector<VertexIndex> &queryMap)
+          : m_query(&query), m_graph(&graph), m_queryMap(&queryMap)
+        {
+        }
+
+        /**
+         * @brief Get the number of query vertices.
+         */
+        std::size_t size() const
+        {
+          return m_queryMap->size();
+        }
+
+        /**
+         * @brief Get the graph vertex that a query vertex is mapped to.
+         */
+        GraphVertex operator[](QueryVertex u) const
+        {
+          return getVertex(*m_graph, (*m_queryMap)[getVertexIndex(*m_query, u)]);
+        }
+
+        /**
+         * @brief Copy the mapping to a property map.
+         */
+        VertexPropertyMap<Query, GraphVertex> toPropertyMap() const
+        {
+          VertexPropertyMap<Query, GraphVertex> map(*m_query);
+          for (auto u : getVertices(*m_query))
+            map[u] = (*this)[u];
+          return map;
+        }
+
+      private:
+        const Query *m_query;
+        const Graph *m_graph;
+        const std::vector<VertexIndex> *m_queryMap;
+    };
+
     namespace impl {
 
-      template<typename QueryT, typename GraphT>
+      template<typename QueryT, typename GraphT,
+               typename VertexMatcherT = AlwaysMatch,
+               typename EdgeMatcherT = AlwaysMatch>
       class VF2State
       {
         public:
@@ -25,8 +96,8 @@ namespace ocgl {
           using GraphVertex = typename GraphTraits<Graph>::Vertex;
           using GraphEdge = typename GraphTraits<Graph>::Edge;
 
-          using VertexMatcher = std::function<bool(const QueryVertex&, const GraphVertex&)>;
-          using EdgeMatcher = std::function<bool(const QueryEdge&, const GraphEdge&)>;
+          using VertexMatcher = VertexMatcherT;
+          using EdgeMatcher = EdgeMatcherT;
 
           using Solution = VertexPropertyMap<Query, GraphVertex>;
 
@@ -35,20 +106,35 @@ namespace ocgl {
             return std::numeric_limits<VertexIndex>::max();
           }
 
+          /**
+           * @brief Constructor.
+           *
+           * The plan for the query is computed and owned by the state.
+           */
           VF2State(const Query &query, const Graph &graph,
-              VertexMatcher vertexMatcher = nullptr,
-              EdgeMatcher edgeMatcher = nullptr)
-            : m_query(&query), m_graph(&graph),
-              m_queryMap(numVertices(query), NoIndex()),
-              m_graphMap(numVertices(graph), NoIndex()),
-              m_vertexMatcher(vertexMatcher),
-              m_edgeMatcher(edgeMatcher),
-              m_queryTUM(numVertices(query), 0),
-              m_graphTUM(numVertices(graph), 0),
-              m_mapSize(0), m_queryTUMSize(0), m_graphTUMSize(0)
+              VertexMatcher vertexMatcher = VertexMatcher(),
+              EdgeMatcher edgeMatcher = EdgeMatcher())
+            : VF2State(&query, nullptr, graph, vertexMatcher, edgeMatcher)
+          {
+          }
+
+          /**
+           * @brief Constructor using a precomputed plan.
+           *
+           * The plan is not copied and must outlive the state, this allows
+           * reusing the plan for many graphs.
+           */
+          VF2State(const MatchPlan<Query> &plan, const Graph &graph,
+              VertexMatcher vertexMatcher = VertexMatcher(),
+              EdgeMatcher edgeMatcher = EdgeMatcher())
+            : VF2State(nullptr, &plan, graph, vertexMatcher, edgeMatcher)
           {
           }
 
+          // m_plan may point to m_ownedPlan
+          VF2State(const VF2State&) = delete;
+          VF2State& operator=(const VF2State&) = delete;
+
           const Query& query() const
           {
             return *m_query;
@@ -59,6 +145,82 @@ namespace ocgl {
             return *m_graph;
           }
 
+          const MatchPlan<Query>& plan() const
+          {
+            return *m_plan;
+          }
+
+          /**
+           * @brief Make sure the graph buffers can hold numVertices vertices.
+           */
+          void reserve(unsigned int numVertices)
+          {
+            if (numVertices <= m_graphMap.size())
+              return;
+
+            m_graphMap.resize(numVertices, NoIndex());
+            m_graphTUM.resize(numVertices, 0);
+          }
+
+          /**
+           * @brief Search in another graph, reusing the buffers.
+           *
+           * The buffers are only grown, so a state can be reused for many
+           * graphs without allocations.
+           *
+           * @pre The state is empty (i.e. no pairs added).
+           */
+          void setGraph(const Graph &graph)
+          {
+            PRE_EQ(m_mapSize, 0);
+            m_graph = &graph;
+            m_domains = nullptr;
+            reserve(numVertices(graph));
+          }
+
+          /**
+           * @brief Search another query, reusing the buffers.
+           *
+           * Together with setGraph(), one state can be shared by many
+           * queries and graphs: the graph buffers are only grown and the
+           * query buffers are resized to the plan's query. setPlan() removes
+           * the domains.
+           *
+           * @pre The state is empty (i.e. no pairs added).
+           */
+          void setPlan(const MatchPlan<Query> &plan)
+          {
+            PRE_EQ(m_mapSize, 0);
+            m_plan = &plan;
+            m_query = &plan.query();
+            m_domains = nullptr;
+
+            auto n = numVertices(plan.query());
+            m_queryMap.assign(n, NoIndex());
+            m_queryTUM.assign(n, 0);
+            m_queryTUMSize = 0;
+            if (m_frontiers.size() < n)
+              m_frontiers.resize(n);
+          }
+
+          /**
+           * @brief Only map query vertices to graph vertices in their domain.
+           *
+           * The domains replace the vertex matcher: the candidates are taken
+           * from the domain bitsets and the vertex matcher is not called
+           * during the search. The domains must be computed for the state's
+           * graph with the same matchers and must outlive the search.
+           * setGraph() removes the domains.
+           *
+           * @pre The state is empty (i.e. no pairs added).
+           */
+          void setDomains(const CandidateDomains<Query, Graph> *domains)
+          {
+            PRE_EQ(m_mapSize, 0);
+            PRE(!domains || &domains->graph() == m_graph);
+            m_domains = domains;
+          }
+
           unsigned int queryTSize() const
           {
             return m_queryTUMSize - m_mapSize;
@@ -96,62 +258,49 @@ namespace ocgl {
           }
           */
 
+          /**
+           * @brief Add the next feasible pair after (u, v).
+           *
+           * If u is null or already mapped, a new query vertex is selected
+           * for the current depth. Otherwise, the search continues with the
+           * graph vertices after v for u. On success, the pair is added and
+           * (u, v) is set to it.
+           *
+           * @return True if a feasible pair was added.
+           */
           bool nextPair(QueryVertex &u, GraphVertex &v)
           {
-            Index ui = isValidVertex(query(), u) ? getVertexIndex(query(), u) : 0;
-            Index vi = isValidVertex(graph(), v) ? getVertexIndex(graph(), v) + 1 : 0;
-
-            auto querySize = numVertices(query());
-            auto graphSize = numVertices(graph());
-
-            if (queryTSize() && graphTSize()) {
-              // both queryT(s) and graphT(s) are not empty
-              // P(s) = queryT(s) x { min graphT(s) }
-              while (ui < querySize && !isInQueryT(ui)) {
-                ++ui;
-                vi = 0;
-              }
-              while (vi < graphSize && !isInGraphT(vi))
-                ++vi;
-            } else {
-              // P(s) = ( queryN - queryM ) x { min ( graphN - graphM ) }
-              while (ui < querySize && isInQueryM(ui)) {
-                ++ui;
-                vi = 0;
-              }
-              while (vi < graphSize && isInGraphM(vi))
-                ++vi;
-            }
-
-            if (ui < querySize && vi < graphSize) {
-              u = getVertex(query(), ui);
-              v = getVertex(graph(), vi);
-
-              if (isFeasiblePair(u, v)) {
-                addPair(u, v);
-                return true;
-              }
-
-              return nextPair(u, v);
+            auto local = VF2State::local();
+
+            if (isValidVertex(query(), u) &&
+                !isInQueryM(getVertexIndex(query(), u))) {
+              // continue with the candidates for u after v
+              local.u = u;
+              selectCandidates(local);
+              if (isValidVertex(graph(), v))
+                skipCandidates(local, v);
             }
 
-            u = NoIndex();
-            v = NoIndex();
-
-            return false;
+            bool found = next(local);
+            u = found ? local.u : nullVertex<Query>();
+            v = local.v;
+            return found;
           }
 
           bool isFeasiblePair(QueryVertex u, GraphVertex v)
           {
             //std::cout <<"isFeasiblePair(" << u.index() << ", " << v.index() << ")" << std::endl;
 
-            // compare vertex labels if there is a vertex matcher
-            if (m_vertexMatcher && !m_vertexMatcher(u, v))
-              return false;
-
             auto ui = getVertexIndex(query(), u);
             auto vi = getVertexIndex(graph(), v);
 
+            // compare vertex labels
+            if (m_domains) {
+              if (!m_domains->containsIndex(ui, vi))
+                return false;
+            } else if (!m_vertexMatcher(u, v))
+              return false;
+
             // the number of nbrs u that has in query T should not be larger
             // than the number of nbrs v has in graph T
             int queryNbrTSize = 0;
@@ -167,19 +316,16 @@ namespace ocgl {
               return false;
 
             // for each nbr of u that is in query M, there should be a matching
-            // edge in the graph
-            for (auto e : getIncident(query(), u)) {
-              auto w = getOther(query(), e, u);
-              auto wi = getVertexIndex(query(), w);
-              if (!isInQueryM(wi))
-                continue;
-
+            // edge in the graph (the plan's checks are the nbrs of u that are
+            // matched before u)
+            for (const auto &check : m_plan->checks(m_plan->depth(u))) {
+              auto wi = getVertexIndex(query(), check.vertex);
               auto wGraph = getVertex(graph(), m_queryMap[wi]);
               auto eGraph = getEdge(graph(), v, wGraph);
               if (!isValidEdge(graph(), eGraph))
                 return false;
 
-              if (m_edgeMatcher && !m_edgeMatcher(e, eGraph))
+              if (!m_edgeMatcher(check.edge, eGraph))
                 return false;
             }
 
@@ -272,15 +418,30 @@ namespace ocgl {
             m_graphMap[vi] = NoIndex();
           }
 
+          /**
+           * @brief The candidate pairs for a single depth.
+           *
+           * The query vertex u is given by the plan. If u has a parent in
+           * the plan, the candidates for u are the unmapped neighbours of the
+           * parent's image. Any vertex that is not adjacent to this image
+           * fails isFeasiblePair(), so these candidates are the only ones that
+           * need to be visited. The
+           * candidates are stored in a per-depth frontier and pos is the
+           * position of the next candidate in this frontier. When there is
+           * no parent, pos is the index of the next graph vertex.
+           */
           struct LocalState
           {
             QueryVertex u;
             GraphVertex v;
+            QueryVertex parent;
+            std::size_t pos;
           };
 
           static LocalState local()
           {
-            return LocalState{nullVertex<Query>(), nullVertex<Graph>()};
+            return LocalState{nullVertex<Query>(), nullVertex<Graph>(),
+                nullVertex<Query>(), 0};
           }
 
           bool isGoal() const
@@ -290,12 +451,25 @@ namespace ocgl {
 
           bool isDead() const
           {
+            // an empty domain can only be checked once
+            if (!m_mapSize && m_domains && m_domains->isEmpty())
+              return true;
+
             return queryTSize() > graphTSize();
           }
 
           bool next(LocalState &local)
           {
-            return nextPair(local.u, local.v);
+            if (!isValidVertex(query(), local.u) && !selectQueryVertex(local))
+              return false;
+
+            while (nextCandidate(local))
+              if (isFeasiblePair(local.u, local.v)) {
+                addPair(local.u, local.v);
+                return true;
+              }
+
+            return false;
           }
 
           void backtrack(const LocalState &local)
@@ -303,15 +477,149 @@ namespace ocgl {
             removePair(local.u, local.v);
           }
 
+          /**
+           * @brief Get a view of the current mapping (no allocations).
+           */
+          MappingView<Query, Graph> mapping() const
+          {
+            return MappingView<Query, Graph>(query(), graph(), m_queryMap);
+          }
+
           Solution solution() const
           {
-            VertexPropertyMap<Query, GraphVertex> map(query());
-            for (auto v : getVertices(query()))
-              map[v] = getVertex(graph(), m_queryMap[getVertexIndex(query(), v)]);
-            return map;
+            return mapping().toPropertyMap();
           }
 
         private:
+          /**
+           * @brief Constructor, the plan is computed for ownedQuery if it is
+           *        not null.
+           */
+          VF2State(const Query *ownedQuery, const MatchPlan<Query> *plan,
+              const Graph &graph, VertexMatcher vertexMatcher,
+              EdgeMatcher edgeMatcher)
+            : m_ownedPlan(ownedQuery ? MatchPlan<Query>(*ownedQuery) :
+                MatchPlan<Query>()),
+              m_plan(ownedQuery ? &m_ownedPlan : plan),
+              m_query(&m_plan->query()), m_graph(&graph),
+              m_vertexMatcher(vertexMatcher),
+              m_edgeMatcher(edgeMatcher),
+              m_queryMap(numVertices(query()), NoIndex()),
+              m_graphMap(numVertices(graph), NoIndex()),
+              m_queryTUM(numVertices(query()), 0),
+              m_graphTUM(numVertices(graph), 0),
+              m_frontiers(numVertices(query())),
+              m_domains(nullptr), m_mapSize(0), m_queryTUMSize(0), m_graphTUMSize(0)
+          {
+          }
+
+          /**
+           * @brief Select the query vertex for the current depth.
+           *
+           * The query vertices are matched in the order of the plan.
+           */
+          bool selectQueryVertex(LocalState &local)
+          {
+            if (m_mapSize == m_plan->size())
+              return false;
+
+            local.u = m_plan->vertex(m_mapSize);
+            selectCandidates(local);
+            return true;
+          }
+
+          /**
+           * @brief Select the candidate graph vertices for local.u.
+           *
+           * If u has a parent in the plan, the unmapped neighbours of the
+           * parent's image are copied to the frontier for the current depth.
+           * With domains, the frontier is intersected with the domain of u.
+           */
+          void selectCandidates(LocalState &local)
+          {
+            local.parent = m_plan->parent(m_mapSize);
+            local.v = nullVertex<Graph>();
+            local.pos = 0;
+
+            if (!isValidVertex(query(), local.parent))
+              return;
+
+            auto &frontier = m_frontiers[m_mapSize];
+            frontier.clear();
+            auto image = getVertex(graph(),
+                m_queryMap[getVertexIndex(query(), local.parent)]);
+            auto ui = getVertexIndex(query(), local.u);
+            for (auto w : getAdjacent(graph(), image)) {
+              auto wi = getVertexIndex(graph(), w);
+              if (isInGraphM(wi))
+                continue;
+              if (m_domains && !m_domains->containsIndex(ui, wi))
+                continue;
+              frontier.push_back(w);
+            }
+          }
+
+          /**
+           * @brief Skip the candidates up to and including v.
+           */
+          void skipCandidates(LocalState &local, GraphVertex v)
+          {
+            if (isValidVertex(query(), local.parent)) {
+              const auto &frontier = m_frontiers[m_mapSize];
+              auto iter = std::find(frontier.begin(), frontier.end(), v);
+              local.pos = iter == frontier.end() ? frontier.size() :
+                  iter - frontier.begin() + 1;
+            } else
+              local.pos = getVertexIndex(graph(), v) + 1;
+          }
+
+          /**
+           * @brief Set local.v to the next candidate graph vertex.
+           *
+           * @return False if there are no more candidates.
+           */
+          bool nextCandidate(LocalState &local)
+          {
+            if (isValidVertex(query(), local.parent)) {
+              const auto &frontier = m_frontiers[m_mapSize];
+              while (local.pos < frontier.size()) {
+                auto v = frontier[local.pos++];
+                if (!isInGraphM(getVertexIndex(graph(), v))) {
+                  local.v = v;
+                  return true;
+                }
+              }
+            } else if (m_domains) {
+              // visit the set bits of the domain of u
+              auto ui = getVertexIndex(query(), local.u);
+              auto graphSize = numVertices(graph());
+              while ((local.pos = m_domains->nextCandidate(ui, local.pos)) <
+                  graphSize) {
+                auto vi = local.pos++;
+                if (!isInGraphM(vi)) {
+                  local.v = getVertex(graph(), vi);
+                  return true;
+                }
+              }
+            } else {
+              auto graphSize = numVertices(graph());
+              while (local.pos < graphSize) {
+                auto vi = local.pos++;
+                if (!isInGraphM(vi)) {
+                  local.v = getVertex(graph(), vi);
+                  return true;
+                }
+              }
+            }
+
+            local.v = nullVertex<Graph>();
+            return false;
+          }
+
+          // the plan if the state was constructed from a query (empty
+          // otherwise, m_plan may point to it)
+          MatchPlan<Query> m_ownedPlan;
+          const MatchPlan<Query> *m_plan;
           const Query *m_query;
           const Graph *m_graph;
           VertexMatcher m_vertexMatcher;
@@ -320,6 +628,8 @@ namespace ocgl {
           std::vector<VertexIndex> m_graphMap;
           std::vector<VertexIndex> m_queryTUM;
           std::vector<VertexIndex> m_graphTUM;
+          std::vector<std::vector<GraphVertex>> m_frontiers;
+          const CandidateDomains<Query, Graph> *m_domains;
           unsigned int m_mapSize;
           unsigned int m_queryTUMSize;
           unsigned int m_graphTUMSize;
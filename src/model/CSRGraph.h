@@ -0,0 +1,330 @@
+#ifndef OCGL_MODEL_CSR_GRAPH_H
+#define OCGL_MODEL_CSR_GRAPH_H
+
+#include <ocgl/Contract.h>
+#include <ocgl/Range.h>
+#include <ocgl/EdgeLookup.h>
+#include <ocgl/model/IndexGraph.h>
+
+#include <vector>
+#include <limits>
+
+/**
+ * @file CSRGraph.h
+ * @brief Immutable graph model using compressed sparse row storage.
+ */
+
+namespace ocgl {
+
+  namespace model {
+
+    /**
+     * @class CSRGraph CSRGraph.h <ocgl/model/CSRGraph.h>
+     * @brief Immutable graph model using compressed sparse row storage.
+     *
+     * The CSRGraph stores the adjacency of all vertices in contiguous arrays.
+     * For a vertex v, the incident edges and adjacent vertices are stored in
+     * the range [offsets[v], offsets[v + 1]) of the incident and adjacent
+     * arrays. The adjacent array is parallel to the incident array, so
+     * iterating over adjacent vertices does not require looking up the
+     * edge's source and target.
+     *
+     * A CSRGraph can not be edited once it is created. It is intended for
+     * read-only analysis of graphs that were created using an editable graph
+     * model (e.g. IndexGraph) or read from an edge list. The order of the
+     * incident edges for each vertex is the same as for the IndexGraph that
+     * would result from adding the edges in order, so algorithms return the
+     * same results for both models.
+     *
+     * Optionally, an EdgeLookup hash table can be built when the graph is
+     * created. This makes getEdge(g, v, w) and isConnected(g, v, w) O(1),
+     * independent of the vertex degrees. Without the edge lookup, the
+     * adjacent vertices of the lowest degree vertex are searched.
+     */
+    class CSRGraph
+    {
+      public:
+        /**
+         * @brief Constructor for an empty graph.
+         */
+        CSRGraph() : m_offsets(1, 0)
+        {
+        }
+
+        /**
+         * @brief Constructor.
+         *
+         * Create a CSRGraph with the same vertices, edges and incident edge
+         * order as an IndexGraph.
+         *
+         * @param g The IndexGraph.
+         * @param edgeLookup When true, an EdgeLookup is built.
+         *
+         * @pre g has no removed vertices or edges (see compact())
+         */
+        explicit CSRGraph(const IndexGraph &g, bool edgeLookup = false)
+          : m_offsets(1, 0), m_edges(g.edges)
+        {
+          PRE_EQ(g.numRemovedVertices, 0);
+          PRE_EQ(g.numRemovedEdges, 0);
+
+          m_offsets.reserve(g.incident.size() + 1);
+          m_incident.reserve(2 * g.edges.size());
+          m_adjacent.reserve(2 * g.edges.size());
+
+          for (VertexIndex v = 0; v < g.incident.size(); ++v) {
+            for (auto e : g.incident[v]) {
+              auto &edge = m_edges[e];
+              m_incident.push_back(e);
+              m_adjacent.push_back(edge.first == v ? edge.second : edge.first);
+            }
+            m_offsets.push_back(m_incident.size());
+          }
+
+          if (edgeLookup)
+            buildEdgeLookup();
+        }
+
+        /**
+         * @brief Constructor.
+         *
+         * Create a CSRGraph from an edge list. The edge index is the position
+         * of the edge in the list.
+         *
+         * @param numVertices The number of vertices.
+         * @param edges The edges as (source, target) vertex index pairs.
+         * @param edgeLookup When true, an EdgeLookup is built.
+         *
+         * @pre source < numVertices && target < numVertices (for all edges)
+         */
+        CSRGraph(unsigned int numVertices,
+            const std::vector<std::pair<VertexIndex, VertexIndex>> &edges,
+            bool edgeLookup = false)
+          : m_offsets(numVertices + 1, 0), m_edges(edges)
+        {
+          // count the degree of all vertices
+          for (auto &edge : m_edges) {
+            PRE_LT(edge.first, numVertices);
+            PRE_LT(edge.second, numVertices);
+            ++m_offsets[edge.first + 1];
+            ++m_offsets[edge.second + 1];
+          }
+
+          // prefix sum gives the offsets
+          for (std::size_t i = 1; i < m_offsets.size(); ++i)
+            m_offsets[i] += m_offsets[i - 1];
+
+          // fill the incident and adjacent arrays
+          m_incident.resize(2 * m_edges.size());
+          m_adjacent.resize(2 * m_edges.size());
+          std::vector<Index> next(m_offsets.begin(), m_offsets.end() - 1);
+          for (EdgeIndex e = 0; e < m_edges.size(); ++e) {
+            auto v = m_edges[e].first;
+            auto w = m_edges[e].second;
+            m_incident[next[v]] = e;
+            m_adjacent[next[v]++] = w;
+            m_incident[next[w]] = e;
+            m_adjacent[next[w]++] = v;
+          }
+
+          if (edgeLookup)
+            buildEdgeLookup();
+        }
+
+        /**
+         * @brief Get the offsets (i.e. numVertices + 1 elements).
+         */
+        const std::vector<Index>& offsets() const
+        {
+          return m_offsets;
+        }
+
+        /**
+         * @brief Get the incident edge indices for all vertices.
+         */
+        const std::vector<EdgeIndex>& incident() const
+        {
+          return m_incident;
+        }
+
+        /**
+         * @brief Get the adjacent vertex indices for all vertices.
+         */
+        const std::vector<VertexIndex>& adjacent() const
+        {
+          return m_adjacent;
+        }
+
+        /**
+         * @brief Get the edges as (source, target) vertex index pairs.
+         */
+        const std::vector<std::pair<VertexIndex, VertexIndex>>& edges() const
+        {
+          return m_edges;
+        }
+
+        /**
+         * @brief Check if the graph has an edge lookup table.
+         */
+        bool hasEdgeLookup() const
+        {
+          return !m_edgeLookup.empty();
+        }
+
+        /**
+         * @brief Get the edge lookup table.
+         */
+        const EdgeLookup& edgeLookup() const
+        {
+          return m_edgeLookup;
+        }
+
+      private:
+        void buildEdgeLookup()
+        {
+          m_edgeLookup.reserve(m_edges.size());
+          for (EdgeIndex e = 0; e < m_edges.size(); ++e)
+            m_edgeLookup.insert(m_edges[e].first, m_edges[e].second, e);
+        }
+
+        /**
+         * @brief Vertex index -> offset in m_incident and m_adjacent.
+         */
+        std::vector<Index> m_offsets;
+        /**
+         * @brief Incident edge indices.
+         */
+        std::vector<EdgeIndex> m_incident;
+        /**
+         * @brief Adjacent vertex indices (parallel to m_incident).
+         */
+        std::vector<VertexIndex> m_adjacent;
+        /**
+         * @brief Edge index -> source & target vertex index.
+         */
+        std::vector<std::pair<VertexIndex, VertexIndex>> m_edges;
+        /**
+         * @brief Optional (unordered) vertex pair -> edge index table.
+         */
+        EdgeLookup m_edgeLookup;
+    };
+
+  } // namespace model
+
+  template<>
+  struct GraphTraits<model::CSRGraph>
+  {
+    using Vertex = VertexIndex;
+    using Edge = EdgeIndex;
+    using VertexIter = model::IndexIterator;
+    using EdgeIter = model::IndexIterator;
+    using IncidentIter = std::vector<EdgeIndex>::const_iterator;
+    using AdjacentIter = std::vector<VertexIndex>::const_iterator;
+
+    static constexpr bool hasEdgeLookup = true;
+
+    static Vertex nullVertex()
+    {
+      return std::numeric_limits<Index>::max();
+    }
+
+    static Edge nullEdge()
+    {
+      return std::numeric_limits<Index>::max();
+    }
+  };
+
+  namespace model {
+
+    inline unsigned int num_vertices(const CSRGraph &g)
+    {
+      return g.offsets().size() - 1;
+    }
+
+    inline unsigned int num_edges(const CSRGraph &g)
+    {
+      return g.edges().size();
+    }
+
+    inline Range<IndexIterator> get_vertices(const CSRGraph &g)
+    {
+      return makeRange(IndexIterator(0), IndexIterator(num_vertices(g)));
+    }
+
+    inline Range<IndexIterator> get_edges(const CSRGraph &g)
+    {
+      return makeRange(IndexIterator(0), IndexIterator(num_edges(g)));
+    }
+
+    inline VertexIndex get_vertex(const CSRGraph&, VertexIndex index)
+    {
+      return index;
+    }
+
+    inline EdgeIndex get_edge(const CSRGraph&, EdgeIndex index)
+    {
+      return index;
+    }
+
+    inline VertexIndex get_vertex_index(const CSRGraph&, VertexIndex index)
+    {
+      return index;
+    }
+
+    inline EdgeIndex get_edge_index(const CSRGraph&, EdgeIndex index)
+    {
+      return index;
+    }
+
+    inline unsigned int get_degree(const CSRGraph &g, VertexIndex v)
+    {
+      return g.offsets()[v + 1] - g.offsets()[v];
+    }
+
+    inline Range<std::vector<EdgeIndex>::const_iterator>
+    get_incident(const CSRGraph &g, VertexIndex v)
+    {
+      auto begin = g.incident().begin();
+      return makeRange(begin + g.offsets()[v], begin + g.offsets()[v + 1]);
+    }
+
+    inline Range<std::vector<VertexIndex>::const_iterator>
+    get_adjacent(const CSRGraph &g, VertexIndex v)
+    {
+      auto begin = g.adjacent().begin();
+      return makeRange(begin + g.offsets()[v], begin + g.offsets()[v + 1]);
+    }
+
+    inline VertexIndex get_source(const CSRGraph &g, EdgeIndex e)
+    {
+      return g.edges()[e].first;
+    }
+
+    inline VertexIndex get_target(const CSRGraph &g, EdgeIndex e)
+    {
+      return g.edges()[e].second;
+    }
+
+    inline EdgeIndex find_edge(const CSRGraph &g, VertexIndex v, VertexIndex w)
+    {
+      if (g.hasEdgeLookup())
+        return g.edgeLookup().find(v, w);
+
+      // search the adjacent vertices of the lowest degree vertex
+      if (get_degree(g, w) < get_degree(g, v))
+        std::swap(v, w);
+
+      auto &offsets = g.offsets();
+      auto &adjacent = g.adjacent();
+      for (auto i = offsets[v]; i < offsets[v + 1]; ++i)
+        if (adjacent[i] == w)
+          return g.incident()[i];
+
+      return std::numeric_limits<Index>::max();
+    }
+
+  } // namespace model
+
+} // namespace ocgl
+
+#endif // OCGL_MODEL_CSR_GRAPH_H
@@ -16,8 +16,10 @@ namespace ocgl {
     class IndexIterator : public std::iterator<std::forward_iterator_tag, Index>
     {
       public:
-        IndexIterator(Index index) : m_index(index)
+        IndexIterator(Index index, const std::vector<bool> *removed = nullptr)
+          : m_index(index), m_removed(removed)
         {
+          skipRemoved();
         }
 
         Index operator*() const
@@ -28,6 +30,7 @@ namespace ocgl {
         IndexIterator& operator++()
         {
           ++m_index;
+          skipRemoved();
           return *this;
         }
 
@@ -35,6 +38,7 @@ namespace ocgl {
         {
           IndexIterator tmp = *this;
           ++m_index;
+          skipRemoved();
           return tmp;
         }
 
@@ -49,7 +53,17 @@ namespace ocgl {
         }
 
       private:
+        void skipRemoved()
+        {
+          if (!m_removed)
+            return;
+          while (m_index < m_removed->size() && (*m_removed)[m_index])
+            ++m_index;
+        }
+
         Index m_index;
+        // index -> removed (i.e. tombstone), may be null
+        const std::vector<bool> *m_removed;
     };
 
     struct IndexGraph
@@ -65,6 +79,33 @@ namespace ocgl {
       std::vector<std::vector<EdgeIndex>> incident;
       // edge index -> source & target vertex index
       std::vector<std::pair<VertexIndex, VertexIndex>> edges;
+
+      // when true, remove_vertex() and remove_edge() only mark the vertex or
+      // edge as removed (i.e. tombstone) and indices remain stable until
+      // compact() is called
+      bool tombstones = false;
+      // vertex index -> removed (tombstone mode only)
+      std::vector<bool> removedVertices;
+      // edge index -> removed (tombstone mode only)
+      std::vector<bool> removedEdges;
+      // the number of removed vertices (tombstone mode only)
+      unsigned int numRemovedVertices = 0;
+      // the number of removed edges (tombstone mode only)
+      unsigned int numRemovedEdges = 0;
+    };
+
+    /**
+     * @brief Old to new index maps returned by compact().
+     *
+     * Removed vertices and edges map to
+     * std::numeric_limits<Index>::max().
+     */
+    struct IndexGraphRemap
+    {
+      // old vertex index -> new vertex index
+      std::vector<VertexIndex> vertices;
+      // old edge index -> new edge index
+      std::vector<EdgeIndex> edges;
     };
 
   } // namespace model
@@ -93,6 +134,10 @@ namespace ocgl {
 
   namespace model {
 
+    // In tombstone mode, the number of vertices and edges includes the removed
+    // ones (i.e. one more than the largest index) so property maps remain
+    // valid. Algorithms that depend on the number of vertices or edges (e.g.
+    // circuitRank()) should only be used after calling compact().
     inline unsigned int num_vertices(const IndexGraph &g)
     {
       return g.incident.size();
@@ -105,12 +150,15 @@ namespace ocgl {
 
     inline Range<IndexIterator> get_vertices(const IndexGraph &g)
     {
-      return makeRange(IndexIterator(0), IndexIterator(num_vertices(g)));
+      auto removed = g.numRemovedVertices ? &g.removedVertices : nullptr;
+      return makeRange(IndexIterator(0, removed),
+          IndexIterator(num_vertices(g)));
     }
 
     inline Range<IndexIterator> get_edges(const IndexGraph &g)
     {
-      return makeRange(IndexIterator(0), IndexIterator(num_edges(g)));
+      auto removed = g.numRemovedEdges ? &g.removedEdges : nullptr;
+      return makeRange(IndexIterator(0, removed), IndexIterator(num_edges(g)));
     }
 
     inline VertexIndex get_vertex(const IndexGraph&, VertexIndex index)
@@ -169,16 +217,44 @@ namespace ocgl {
       return index;
     }
 
-    void remove_edge(IndexGraph &g, EdgeIndex e);
+    /**
+     * @brief Check if a vertex was removed in tombstone mode.
+     */
+    inline bool is_removed_vertex(const IndexGraph &g, VertexIndex v)
+    {
+      return v < g.removedVertices.size() && g.removedVertices[v];
+    }
+
+    /**
+     * @brief Check if an edge was removed in tombstone mode.
+     */
+    inline bool is_removed_edge(const IndexGraph &g, EdgeIndex e)
+    {
+      return e < g.removedEdges.size() && g.removedEdges[e];
+    }
+
+    inline void remove_edge(IndexGraph &g, EdgeIndex e);
 
-    void remove_vertex(IndexGraph &g, VertexIndex v)
+    inline void remove_vertex(IndexGraph &g, VertexIndex v)
     {
+      // already removed in tombstone mode
+      if (is_removed_vertex(g, v))
+        return;
+
       // make copy of incident edges
       std::vector<EdgeIndex> incident(g.incident[v]);
       // remove incident edges
       for (auto e : incident)
         remove_edge(g, e);
 
+      if (g.tombstones) {
+        // mark vertex as removed
+        g.removedVertices.resize(g.incident.size());
+        g.removedVertices[v] = true;
+        ++g.numRemovedVertices;
+        return;
+      }
+
       // remove list of incident edge indices
       g.incident.erase(g.incident.begin() + v);
 
@@ -186,7 +262,7 @@ namespace ocgl {
       for (auto &e : g.edges) {
         if (e.first > v)
           --e.first;
-        else if (e.second > v)
+        if (e.second > v)
           --e.second;
       }
     }
@@ -206,8 +282,12 @@ namespace ocgl {
       return index;
     }
 
-    void remove_edge(IndexGraph &g, EdgeIndex e)
+    inline void remove_edge(IndexGraph &g, EdgeIndex e)
     {
+      // already removed in tombstone mode
+      if (is_removed_edge(g, e))
+        return;
+
       auto v = g.edges[e].first;
       auto w = g.edges[e].second;
 
@@ -217,6 +297,14 @@ namespace ocgl {
       g.incident[v].erase(std::find(g.incident[v].begin(), g.incident[v].end(), e));
       g.incident[w].erase(std::find(g.incident[w].begin(), g.incident[w].end(), e));
 
+      if (g.tombstones) {
+        // mark edge as removed
+        g.removedEdges.resize(g.edges.size());
+        g.removedEdges[e] = true;
+        ++g.numRemovedEdges;
+        return;
+      }
+
       // remove source & target vertex indices
       g.edges.erase(g.edges.begin() + e);
 
@@ -231,6 +319,70 @@ namespace ocgl {
     {
       g.incident.clear();
       g.edges.clear();
+      g.removedVertices.clear();
+      g.removedEdges.clear();
+      g.numRemovedVertices = 0;
+      g.numRemovedEdges = 0;
+    }
+
+    /**
+     * @brief Remove the vertices and edges that are marked as removed.
+     *
+     * In tombstone mode (i.e. IndexGraph::tombstones is true), removing
+     * vertices and edges only marks them as removed. This function removes
+     * them from the graph and renumbers the remaining vertices and edges in
+     * O(V + E) time. The relative order of the vertices, edges and incident
+     * edges is preserved.
+     *
+     * @param g The graph.
+     *
+     * @return The old to new index maps which can be used to update property
+     *         maps (see remapPropertyMap()).
+     */
+    inline IndexGraphRemap compact(IndexGraph &g)
+    {
+      const auto null = std::numeric_limits<Index>::max();
+
+      IndexGraphRemap remap;
+      remap.vertices.resize(g.incident.size(), null);
+      remap.edges.resize(g.edges.size(), null);
+
+      // compute the new vertex indices
+      VertexIndex numVertices = 0;
+      for (VertexIndex v = 0; v < g.incident.size(); ++v)
+        if (!is_removed_vertex(g, v))
+          remap.vertices[v] = numVertices++;
+
+      // compute the new edge indices and update source & target
+      EdgeIndex numEdges = 0;
+      for (EdgeIndex e = 0; e < g.edges.size(); ++e) {
+        if (is_removed_edge(g, e))
+          continue;
+        auto &edge = g.edges[e];
+        g.edges[numEdges] = std::make_pair(remap.vertices[edge.first],
+            remap.vertices[edge.second]);
+        remap.edges[e] = numEdges++;
+      }
+      g.edges.resize(numEdges);
+
+      // move incident lists and update incident edge indices
+      for (VertexIndex v = 0; v < g.incident.size(); ++v) {
+        if (remap.vertices[v] == null)
+          continue;
+        auto &incident = g.incident[remap.vertices[v]];
+        if (remap.vertices[v] != v)
+          incident.swap(g.incident[v]);
+        for (auto &e : incident)
+          e = remap.edges[e];
+      }
+      g.incident.resize(numVertices);
+
+      g.removedVertices.clear();
+      g.removedEdges.clear();
+      g.numRemovedVertices = 0;
+      g.numRemovedEdges = 0;
+
+      return remap;
     }
 
   } // namespace model
@@ -213,6 +213,82 @@ TEST(BitMatrixTest, Eliminate2)
   EXPECT_EQ(2, m.eliminate());
 }
 
+// # bits > 2 blocks
+TEST(BitMatrixTest, Eliminate3)
+{
+  ocgl::BitMatrix m(4, 200);
+
+  // row 0: 150, row 1: 10 & 150, row 2: 70 & 199, row 3: 10 & 70 & 199
+  m.set(0, 150);
+  m.set(1, 10);
+  m.set(1, 150);
+  m.set(2, 70);
+  m.set(2, 199);
+  m.set(3, 10);
+  m.set(3, 70);
+  m.set(3, 199);
+
+  EXPECT_EQ(3, m.eliminate());
+
+  // row echelon form with cached leading bits
+  EXPECT_EQ(10, m.leadingBit(0));
+  EXPECT_EQ(70, m.leadingBit(1));
+  EXPECT_EQ(150, m.leadingBit(2));
+  EXPECT_EQ(200, m.leadingBit(3));
+
+  // 10 & 70 & 150 & 199 is a linear combination
+  m.popRow();
+  m.addRow();
+  m.set(3, 10);
+  m.set(3, 70);
+  m.set(3, 150);
+  m.set(3, 199);
+  EXPECT_EQ(3, m.eliminateLastRow());
+  m.popRow();
+
+  // 10 & 70 is not
+  m.addRow();
+  m.set(3, 10);
+  m.set(3, 70);
+  EXPECT_EQ(4, m.eliminateLastRow());
+  EXPECT_EQ(199, m.leadingBit(3));
+
+  // modifying a row invalidates the cached leading bit
+  m.set(0, 5);
+  EXPECT_EQ(5, m.leadingBit(0));
+  EXPECT_EQ(70, m.leadingBit(1));
+}
+
+TEST(BitMatrixTest, EliminateRow)
+{
+  // row echelon form
+  ocgl::BitMatrix m(2, 4, {
+      1, 1, 0, 0,
+      0, 1, 1, 0 });
+
+  std::vector<ocgl::BitMatrix::Block> row;
+
+  // 1 0 1 0 = row 0 + row 1
+  m.makeRow(row);
+  ocgl::BitMatrix::setBit(row, 0);
+  ocgl::BitMatrix::setBit(row, 2);
+  EXPECT_TRUE(m.eliminateRow(row));
+
+  // 0 1 1 1 is independent
+  m.makeRow(row);
+  ocgl::BitMatrix::setBit(row, 1);
+  ocgl::BitMatrix::setBit(row, 2);
+  ocgl::BitMatrix::setBit(row, 3);
+  EXPECT_FALSE(m.eliminateRow(row));
+
+  // the matrix is not modified
+  EXPECT_EQ(2, m.rows());
+  EXPECT_TRUE(m.get(0, 0));
+  EXPECT_TRUE(m.get(0, 1));
+  EXPECT_TRUE(m.get(1, 1));
+  EXPECT_TRUE(m.get(1, 2));
+}
+
 int main(int argc, char **argv)
 {
   ::testing::InitGoogleTest(&argc, argv);
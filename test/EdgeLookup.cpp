@@ -0,0 +1,54 @@
+#include <ocgl/EdgeLookup.h>
+
+#include <gtest/gtest.h>
+
+TEST(EdgeLookupTest, EdgeLookup)
+{
+  ocgl::EdgeLookup lookup;
+
+  EXPECT_TRUE(lookup.empty());
+  EXPECT_EQ(ocgl::EdgeLookup::nullIndex(), lookup.find(0, 1));
+
+  lookup.insert(0, 1, 0);
+  lookup.insert(2, 1, 1);
+  lookup.insert(5, 3, 2);
+
+  EXPECT_EQ(3, lookup.size());
+  EXPECT_EQ(0, lookup.find(0, 1));
+  EXPECT_EQ(0, lookup.find(1, 0));
+  EXPECT_EQ(1, lookup.find(1, 2));
+  EXPECT_EQ(1, lookup.find(2, 1));
+  EXPECT_EQ(2, lookup.find(3, 5));
+  EXPECT_EQ(ocgl::EdgeLookup::nullIndex(), lookup.find(0, 2));
+  EXPECT_EQ(ocgl::EdgeLookup::nullIndex(), lookup.find(3, 4));
+
+  lookup.clear();
+  EXPECT_TRUE(lookup.empty());
+  EXPECT_EQ(ocgl::EdgeLookup::nullIndex(), lookup.find(0, 1));
+}
+
+TEST(EdgeLookupTest, Rehash)
+{
+  ocgl::EdgeLookup lookup;
+
+  // complete graph on 100 vertices
+  ocgl::EdgeIndex e = 0;
+  for (ocgl::VertexIndex v = 0; v < 100; ++v)
+    for (ocgl::VertexIndex w = v + 1; w < 100; ++w)
+      lookup.insert(w, v, e++);
+
+  EXPECT_EQ(e, lookup.size());
+
+  e = 0;
+  for (ocgl::VertexIndex v = 0; v < 100; ++v)
+    for (ocgl::VertexIndex w = v + 1; w < 100; ++w)
+      EXPECT_EQ(e++, lookup.find(v, w));
+
+  EXPECT_EQ(ocgl::EdgeLookup::nullIndex(), lookup.find(0, 100));
+}
+
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,50 @@
+#include <ocgl/Parallel.h>
+
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+
+TEST(ParallelTest, ParallelFor)
+{
+  for (unsigned int numThreads = 0; numThreads < 5; ++numThreads) {
+    // uneven work load
+    std::vector<std::atomic<int>> counts(1000);
+    std::vector<unsigned int> threads(counts.size());
+
+    ocgl::parallelFor(counts.size(), numThreads,
+        [&] (std::size_t i, unsigned int t) {
+          volatile unsigned int sum = 0;
+          for (std::size_t j = 0; j < (i % 10) * 1000; ++j)
+            sum += j;
+          ++counts[i];
+          threads[i] = t;
+        });
+
+    auto maxThreads = numThreads ? numThreads : ocgl::hardwareThreads();
+    for (std::size_t i = 0; i < counts.size(); ++i) {
+      EXPECT_EQ(1, counts[i]);
+      EXPECT_LT(threads[i], maxThreads);
+    }
+  }
+}
+
+TEST(ParallelTest, Empty)
+{
+  int count = 0;
+  ocgl::parallelFor(0, 4, [&count] (std::size_t, unsigned int) { ++count; });
+  EXPECT_EQ(0, count);
+}
+
+TEST(ParallelTest, Exception)
+{
+  EXPECT_THROW(ocgl::parallelFor(100, 4, [] (std::size_t i, unsigned int) {
+    if (i == 50)
+      throw std::runtime_error("error");
+  }), std::runtime_error);
+}
+
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
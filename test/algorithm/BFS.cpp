@@ -0,0 +1,228 @@
+#include <ocgl/algorithm/BFS.h>
+#include <ocgl/algorithm/BFSShortestPaths.h>
+
+#include "../test.h"
+
+GRAPH_TYPED_TEST(BFSTest);
+
+template<typename Graph>
+struct BFSVisitor : public ocgl::algorithm::BFSVisitor<Graph>
+{
+  using Vertex = typename ocgl::GraphTraits<Graph>::Vertex;
+  using Edge = typename ocgl::GraphTraits<Graph>::Edge;
+
+  BFSVisitor(std::ostream &os_) : os(os_)
+  {
+  }
+
+  void initialize(const Graph&)
+  {
+    os << "initialize()" << std::endl;
+  }
+
+  void vertex(const Graph &g, Vertex v, unsigned int depth)
+  {
+    os << "vertex(" << ocgl::getVertexIndex(g, v) << ", " << depth << ")"
+       << std::endl;
+  }
+
+  void edge(const Graph &g, Edge e)
+  {
+    os << "edge(" << ocgl::getEdgeIndex(g, e) << ")" << std::endl;
+  }
+
+  void nonTreeEdge(const Graph &g, Edge e)
+  {
+    os << "nonTreeEdge(" << ocgl::getEdgeIndex(g, e) << ")" << std::endl;
+  }
+
+  void finishVertex(const Graph &g, Vertex v)
+  {
+    os << "finishVertex(" << ocgl::getVertexIndex(g, v) << ")" << std::endl;
+  }
+
+  std::ostream &os;
+};
+
+template<typename Graph>
+std::string bfsTrace(const std::string &str, std::vector<unsigned int> sources,
+    unsigned int maxDepth = ocgl::algorithm::bfsNoDepthLimit)
+{
+  auto g = ocgl::GraphStringParser<Graph>::parse(str);
+
+  std::vector<typename ocgl::GraphTraits<Graph>::Vertex> V;
+  for (auto i : sources)
+    V.push_back(ocgl::getVertex(g, i));
+
+  std::stringstream ss;
+  BFSVisitor<Graph> visitor(ss);
+
+  ocgl::algorithm::bfs(g, V, visitor, maxDepth);
+
+  return ss.str();
+}
+
+TYPED_TEST(BFSTest, Branches)
+{
+  auto trace = bfsTrace<TypeParam>("**(*)*", {1});
+
+  std::stringstream correct;
+  correct << "initialize()" << std::endl
+          << "vertex(1, 0)" << std::endl
+          << "edge(0)" << std::endl
+          << "vertex(0, 1)" << std::endl
+          << "edge(1)" << std::endl
+          << "vertex(2, 1)" << std::endl
+          << "edge(2)" << std::endl
+          << "vertex(3, 1)" << std::endl
+          << "finishVertex(1)" << std::endl
+          << "finishVertex(0)" << std::endl
+          << "finishVertex(2)" << std::endl
+          << "finishVertex(3)" << std::endl;
+
+  EXPECT_EQ(correct.str(), trace);
+}
+
+TYPED_TEST(BFSTest, Cycle)
+{
+  auto trace = bfsTrace<TypeParam>("*1***1", {0});
+
+  std::stringstream correct;
+  correct << "initialize()" << std::endl
+          << "vertex(0, 0)" << std::endl
+          << "edge(0)" << std::endl
+          << "vertex(1, 1)" << std::endl
+          << "edge(3)" << std::endl
+          << "vertex(3, 1)" << std::endl
+          << "finishVertex(0)" << std::endl
+          << "edge(1)" << std::endl
+          << "vertex(2, 2)" << std::endl
+          << "finishVertex(1)" << std::endl
+          << "nonTreeEdge(2)" << std::endl
+          << "finishVertex(3)" << std::endl
+          << "finishVertex(2)" << std::endl;
+
+  EXPECT_EQ(correct.str(), trace);
+}
+
+TYPED_TEST(BFSTest, MultiSource)
+{
+  auto trace = bfsTrace<TypeParam>("*****.*", {0, 4, 0});
+
+  // vertex 5 is in another component
+  std::stringstream correct;
+  correct << "initialize()" << std::endl
+          << "vertex(0, 0)" << std::endl
+          << "vertex(4, 0)" << std::endl
+          << "edge(0)" << std::endl
+          << "vertex(1, 1)" << std::endl
+          << "finishVertex(0)" << std::endl
+          << "edge(3)" << std::endl
+          << "vertex(3, 1)" << std::endl
+          << "finishVertex(4)" << std::endl
+          << "edge(1)" << std::endl
+          << "vertex(2, 2)" << std::endl
+          << "finishVertex(1)" << std::endl
+          << "nonTreeEdge(2)" << std::endl
+          << "finishVertex(3)" << std::endl
+          << "finishVertex(2)" << std::endl;
+
+  EXPECT_EQ(correct.str(), trace);
+}
+
+TYPED_TEST(BFSTest, DepthLimit)
+{
+  auto trace = bfsTrace<TypeParam>("*1***1", {0}, 1);
+
+  // the edges of the vertices at depth 1 are not examined
+  std::stringstream correct;
+  correct << "initialize()" << std::endl
+          << "vertex(0, 0)" << std::endl
+          << "edge(0)" << std::endl
+          << "vertex(1, 1)" << std::endl
+          << "edge(3)" << std::endl
+          << "vertex(3, 1)" << std::endl
+          << "finishVertex(0)" << std::endl
+          << "finishVertex(1)" << std::endl
+          << "finishVertex(3)" << std::endl;
+
+  EXPECT_EQ(correct.str(), trace);
+}
+
+TYPED_TEST(BFSTest, Mask)
+{
+  auto g = ocgl::GraphStringParser<TypeParam>::parse("*1***1");
+  ocgl::VertexPropertyMap<TypeParam, bool> mask(g, true);
+  mask[ocgl::getVertex(g, 1)] = false;
+
+  std::stringstream ss;
+  BFSVisitor<TypeParam> visitor(ss);
+  ocgl::algorithm::bfs(g, ocgl::getVertex(g, 0), visitor, mask);
+
+  // vertex 1 and its edges are skipped
+  std::stringstream correct;
+  correct << "initialize()" << std::endl
+          << "vertex(0, 0)" << std::endl
+          << "edge(3)" << std::endl
+          << "vertex(3, 1)" << std::endl
+          << "finishVertex(0)" << std::endl
+          << "edge(2)" << std::endl
+          << "vertex(2, 2)" << std::endl
+          << "finishVertex(3)" << std::endl
+          << "finishVertex(2)" << std::endl;
+
+  EXPECT_EQ(correct.str(), ss.str());
+}
+
+TYPED_TEST(BFSTest, Distances)
+{
+  using Vertex = typename ocgl::GraphTraits<TypeParam>::Vertex;
+
+  // a grid has large frontiers, so the bottom-up steps are used
+  const unsigned int size = 60;
+  TypeParam g;
+  for (unsigned int i = 0; i < size * size; ++i)
+    ocgl::addVertex(g);
+  for (unsigned int i = 0; i < size; ++i)
+    for (unsigned int j = 0; j < size; ++j) {
+      auto v = ocgl::getVertex(g, i * size + j);
+      if (j + 1 < size)
+        ocgl::addEdge(g, v, ocgl::getVertex(g, i * size + j + 1));
+      if (i + 1 < size)
+        ocgl::addEdge(g, v, ocgl::getVertex(g, (i + 1) * size + j));
+    }
+  // isolated vertex
+  ocgl::addVertex(g);
+
+  auto source = ocgl::getVertex(g, size * size / 2);
+  auto dist = ocgl::algorithm::bfsDistances(g, std::vector<Vertex>(1, source));
+  ocgl::algorithm::BFSShortestPaths<TypeParam> paths(g, source);
+  for (auto v : ocgl::getVertices(g))
+    EXPECT_EQ(paths.distance(v), dist[v]);
+
+  // depth limit
+  dist = ocgl::algorithm::bfsDistances(g, std::vector<Vertex>(1, source), 3);
+  for (auto v : ocgl::getVertices(g))
+    if (paths.distance(v) <= 3)
+      EXPECT_EQ(paths.distance(v), dist[v]);
+    else
+      EXPECT_EQ(std::numeric_limits<unsigned int>::max(), dist[v]);
+
+  // multiple sources and mask
+  ocgl::VertexPropertyMap<TypeParam, bool> mask(g, true);
+  for (unsigned int j = 0; j + 1 < size; ++j)
+    mask[ocgl::getVertex(g, size * 2 + j)] = false;
+  std::vector<Vertex> sources = {ocgl::getVertex(g, 0),
+      ocgl::getVertex(g, size * size - 1)};
+  dist = ocgl::algorithm::bfsDistances(g, sources, mask);
+  ocgl::algorithm::BFSShortestPaths<TypeParam> paths0(g, sources[0], mask);
+  ocgl::algorithm::BFSShortestPaths<TypeParam> paths1(g, sources[1], mask);
+  for (auto v : ocgl::getVertices(g))
+    EXPECT_EQ(std::min(paths0.distance(v), paths1.distance(v)), dist[v]);
+}
+
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,73 @@
+#include <ocgl/algorithm/BFSShortestPaths.h>
+#include <ocgl/algorithm/Dijkstra.h>
+
+#include "../test.h"
+
+GRAPH_TYPED_TEST(BFSShortestPathsTest);
+
+TYPED_TEST(BFSShortestPathsTest, BFSShortestPaths)
+{
+  using Graph = TypeParam;
+  using Vertex = typename ocgl::GraphTraits<Graph>::Vertex;
+
+  auto g = ocgl::GraphStringParser<Graph>::parse("*1****2*1***2");
+  auto V = ocgl::getVertices(g).toVector();
+
+  ocgl::algorithm::BFSShortestPaths<Graph> bfs(g, V[0]);
+
+  EXPECT_EQ(V[0], bfs.source());
+  EXPECT_EQ(0, bfs.distance(V[0]));
+  EXPECT_EQ(1, bfs.distance(V[1]));
+  EXPECT_EQ(2, bfs.distance(V[2]));
+  EXPECT_EQ(3, bfs.distance(V[3]));
+  EXPECT_EQ(2, bfs.distance(V[4]));
+  EXPECT_EQ(1, bfs.distance(V[5]));
+  EXPECT_EQ(2, bfs.distance(V[6]));
+  EXPECT_EQ(3, bfs.distance(V[7]));
+  EXPECT_EQ(3, bfs.distance(V[8]));
+
+  std::vector<Vertex> path;
+
+  path = bfs.path(V[0]);
+  EXPECT_EQ(std::vector<Vertex>({V[0]}), path);
+
+  path = bfs.path(V[3]);
+  EXPECT_EQ(std::vector<Vertex>({V[0], V[1], V[2], V[3]}), path);
+
+  path = bfs.reversePath(V[8]);
+  EXPECT_EQ(std::vector<Vertex>({V[8], V[4], V[5], V[0]}), path);
+
+  // same distances as Dijkstra
+  ocgl::algorithm::Dijkstra<Graph> dijkstra(g, V[0]);
+  for (auto v : ocgl::getVertices(g))
+    EXPECT_EQ(dijkstra.distance(v), bfs.distance(v));
+}
+
+TYPED_TEST(BFSShortestPathsTest, VertexMask)
+{
+  using Graph = TypeParam;
+  using Vertex = typename ocgl::GraphTraits<Graph>::Vertex;
+
+  auto g = ocgl::GraphStringParser<Graph>::parse("*1****1.*");
+  auto V = ocgl::getVertices(g).toVector();
+
+  ocgl::VertexPropertyMap<Graph, bool> mask(g, true);
+  mask[V[1]] = false;
+
+  ocgl::algorithm::BFSShortestPaths<Graph> bfs(g, V[0], mask);
+
+  EXPECT_EQ(0, bfs.distance(V[0]));
+  EXPECT_EQ(bfs.infinity(), bfs.distance(V[1]));
+  EXPECT_EQ(3, bfs.distance(V[2]));
+  EXPECT_EQ(2, bfs.distance(V[3]));
+  EXPECT_EQ(1, bfs.distance(V[4]));
+  EXPECT_EQ(bfs.infinity(), bfs.distance(V[5]));
+
+  EXPECT_EQ(std::vector<Vertex>({V[0], V[4], V[3], V[2]}), bfs.path(V[2]));
+}
+
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
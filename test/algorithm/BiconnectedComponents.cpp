@@ -0,0 +1,157 @@
+#include <ocgl/algorithm/BiconnectedComponents.h>
+#include <ocgl/algorithm/ConnectedComponents.h>
+#include <ocgl/algorithm/CycleMembership.h>
+#include <ocgl/Cycle.h>
+
+#include "../test.h"
+
+#include <random>
+
+GRAPH_TYPED_TEST(BiconnectedComponentsTest);
+
+template<typename Graph>
+void checkBiconnectedComponents(const Graph &g)
+{
+  auto result = ocgl::algorithm::biconnectedComponents(g);
+
+  // compare with the separate algorithms
+  auto components = ocgl::algorithm::connectedComponents(g);
+  EXPECT_EQ(components.vertices.map(), result.components.vertices.map());
+  EXPECT_EQ(components.edges.map(), result.components.edges.map());
+
+  auto cyclic = ocgl::algorithm::cycleMembership(g);
+  EXPECT_EQ(cyclic.vertices.map(), result.cyclic.vertices.map());
+  EXPECT_EQ(cyclic.edges.map(), result.cyclic.edges.map());
+
+  auto numComponents = ocgl::algorithm::numConnectedComponents(g);
+  EXPECT_EQ(numComponents, result.numComponents());
+  EXPECT_EQ(ocgl::circuitRank(g), result.circuitRank());
+
+  // a bridge or articulation point disconnects its component
+  for (auto e : ocgl::getEdges(g)) {
+    ocgl::VertexEdgePropertyMap<Graph, bool> mask(g, true);
+    mask.edges[e] = false;
+    auto sub = ocgl::makeSubgraph(g, mask);
+    bool bridge = ocgl::algorithm::numConnectedComponents(sub) > numComponents;
+    EXPECT_EQ(bridge, result.bridges[e]);
+    EXPECT_EQ(bridge, result.ringSystems[e] == ocgl::algorithm::noRingSystem);
+    EXPECT_EQ(bridge, !result.cyclic.edges[e]);
+  }
+
+  for (auto v : ocgl::getVertices(g)) {
+    ocgl::VertexEdgePropertyMap<Graph, bool> mask(g, true);
+    mask.vertices[v] = false;
+    for (auto e : ocgl::getIncident(g, v))
+      mask.edges[e] = false;
+    auto sub = ocgl::makeSubgraph(g, mask);
+    bool articulation = ocgl::algorithm::numConnectedComponents(sub) > numComponents;
+    EXPECT_EQ(articulation, result.articulationPoints[v]);
+  }
+}
+
+template<typename Graph>
+void checkBiconnectedComponents(const std::string &str)
+{
+  SCOPED_TRACE(str);
+  checkBiconnectedComponents(ocgl::GraphStringParser<Graph>::parse(str));
+}
+
+TYPED_TEST(BiconnectedComponentsTest, Empty)
+{
+  TypeParam g;
+  auto result = ocgl::algorithm::biconnectedComponents(g);
+  EXPECT_EQ(0, result.numComponents());
+  EXPECT_EQ(0, result.numRingSystems);
+  EXPECT_EQ(0, result.circuitRank());
+}
+
+TYPED_TEST(BiconnectedComponentsTest, Chain)
+{
+  auto g = ocgl::GraphStringParser<TypeParam>::parse("****");
+  auto result = ocgl::algorithm::biconnectedComponents(g);
+
+  EXPECT_EQ(std::vector<unsigned int>({0}), result.circuitRanks);
+  EXPECT_EQ(0, result.numRingSystems);
+  EXPECT_EQ(std::vector<bool>({true, true, true}), result.bridges.map());
+  EXPECT_EQ(std::vector<bool>({false, true, true, false}),
+      result.articulationPoints.map());
+
+  checkBiconnectedComponents<TypeParam>("****");
+}
+
+TYPED_TEST(BiconnectedComponentsTest, Spiro)
+{
+  // two triangles sharing vertex 0
+  auto g = ocgl::GraphStringParser<TypeParam>::parse("*12(**1)**2");
+  auto result = ocgl::algorithm::biconnectedComponents(g);
+
+  EXPECT_EQ(std::vector<unsigned int>({2}), result.circuitRanks);
+  EXPECT_EQ(2, result.numRingSystems);
+  EXPECT_EQ(std::vector<bool>({true, false, false, false, false}),
+      result.articulationPoints.map());
+
+  // the triangles are different ring systems
+  std::vector<unsigned int> triangles(2, ocgl::algorithm::noRingSystem);
+  for (auto e : ocgl::getEdges(g)) {
+    EXPECT_FALSE(result.bridges[e]);
+    auto triangle = ocgl::getVertexIndex(g, ocgl::getSource(g, e)) > 2 ||
+      ocgl::getVertexIndex(g, ocgl::getTarget(g, e)) > 2;
+    if (triangles[triangle] == ocgl::algorithm::noRingSystem)
+      triangles[triangle] = result.ringSystems[e];
+    EXPECT_EQ(triangles[triangle], result.ringSystems[e]);
+  }
+  EXPECT_NE(triangles[0], triangles[1]);
+
+  checkBiconnectedComponents<TypeParam>("*12(**1)**2");
+}
+
+TYPED_TEST(BiconnectedComponentsTest, Graphs)
+{
+  for (const auto &str : {"*", "**", "*1**1", "*1***2*****2*1",
+      "*1*****1**(*)*.*1**1.*", "*1***1*1***1", "*1**(*2***2)**1",
+      "*1*2*3*4*5*16.*2345623456.*12*3*4*5*16.**", "*1*(*)**1*"})
+    checkBiconnectedComponents<TypeParam>(str);
+}
+
+TYPED_TEST(BiconnectedComponentsTest, Random)
+{
+  // sparse random graph with chains, rings and several components
+  const unsigned int numVertices = 60;
+  const unsigned int numEdges = 62;
+
+  TypeParam g;
+  for (unsigned int i = 0; i < numVertices; ++i)
+    ocgl::addVertex(g);
+
+  std::mt19937 generator(42);
+  std::uniform_int_distribution<unsigned int> random(0, numVertices - 1);
+
+  while (ocgl::numEdges(g) < numEdges) {
+    auto v = ocgl::getVertex(g, random(generator));
+    auto w = ocgl::getVertex(g, random(generator));
+    if (v != w && !ocgl::isValidEdge(g, ocgl::getEdge(g, v, w)))
+      ocgl::addEdge(g, v, w);
+  }
+
+  checkBiconnectedComponents(g);
+}
+
+TYPED_TEST(BiconnectedComponentsTest, Workspace)
+{
+  ocgl::algorithm::TraversalWorkspace<TypeParam> workspace;
+  for (const auto &str : {"*1***2*****2*1.**", "*", "*1*****1**(*)*"}) {
+    auto g = ocgl::GraphStringParser<TypeParam>::parse(str);
+    auto result1 = ocgl::algorithm::biconnectedComponents(g);
+    auto result2 = ocgl::algorithm::biconnectedComponents(g, workspace);
+    EXPECT_EQ(result1.ringSystems.map(), result2.ringSystems.map());
+    EXPECT_EQ(result1.bridges.map(), result2.bridges.map());
+    EXPECT_EQ(result1.articulationPoints.map(), result2.articulationPoints.map());
+    EXPECT_EQ(result1.circuitRanks, result2.circuitRanks);
+  }
+}
+
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
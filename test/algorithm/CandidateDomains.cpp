@@ -0,0 +1,165 @@
+#include <ocgl/algorithm/CandidateDomains.h>
+#include <ocgl/algorithm/Isomorphisms.h>
+
+#include "../test.h"
+
+GRAPH_TYPED_TEST(CandidateDomainsTest);
+
+template<typename Query, typename Graph>
+std::vector<unsigned int> domain(
+    const ocgl::algorithm::CandidateDomains<Query, Graph> &domains,
+    unsigned int u)
+{
+  std::vector<unsigned int> result;
+  auto n = ocgl::numVertices(domains.graph());
+  for (auto v = domains.nextCandidate(u, 0); v < n;
+      v = domains.nextCandidate(u, v + 1))
+    result.push_back(v);
+  return result;
+}
+
+TYPED_TEST(CandidateDomainsTest, Degree)
+{
+  auto query = ocgl::GraphStringParser<TypeParam>::parse("**(*)*");
+  auto graph = ocgl::GraphStringParser<TypeParam>::parse("***(*)*");
+
+  ocgl::algorithm::CandidateDomains<TypeParam, TypeParam> domains(query);
+  domains.compute(graph);
+
+  // the degree 3 vertex can only be mapped to the degree 3 vertex
+  EXPECT_EQ(std::vector<unsigned int>({2}), domain(domains, 1));
+  EXPECT_EQ(1, domains.size(ocgl::getVertex(query, 1)));
+  // the leaves have to be neighbours of the degree 3 vertex
+  EXPECT_EQ(std::vector<unsigned int>({1, 3, 4}), domain(domains, 0));
+  EXPECT_EQ(3, domains.size(ocgl::getVertex(query, 0)));
+  EXPECT_TRUE(domains.contains(ocgl::getVertex(query, 1),
+        ocgl::getVertex(graph, 2)));
+  EXPECT_FALSE(domains.contains(ocgl::getVertex(query, 1),
+        ocgl::getVertex(graph, 1)));
+  EXPECT_FALSE(domains.isEmpty());
+}
+
+TYPED_TEST(CandidateDomainsTest, Cycles)
+{
+  auto query = ocgl::GraphStringParser<TypeParam>::parse("*1**1");
+  auto graph = ocgl::GraphStringParser<TypeParam>::parse("**1***1*");
+
+  ocgl::algorithm::CandidateDomains<TypeParam, TypeParam> domains(query);
+  domains.compute(graph);
+
+  // only the ring vertices
+  for (unsigned int u = 0; u < 3; ++u)
+    EXPECT_EQ(std::vector<unsigned int>({1, 2, 3, 4}), domain(domains, u));
+
+  domains.compute(ocgl::GraphStringParser<TypeParam>::parse("******"));
+  EXPECT_TRUE(domains.isEmpty());
+}
+
+TYPED_TEST(CandidateDomainsTest, SharedTargetData)
+{
+  auto graph = ocgl::GraphStringParser<TypeParam>::parse("*1*****1**(*)*");
+
+  // the per-vertex data is computed once for all queries
+  ocgl::algorithm::TargetVertexData<TypeParam> data;
+  data.computeDegrees(graph);
+  data.computeCycles(graph, ocgl::algorithm::cycleMembership(graph));
+  EXPECT_EQ(3, data.degree(5));
+  EXPECT_EQ(2, data.degree(1));
+  EXPECT_TRUE(data.isCyclic(0));
+  EXPECT_FALSE(data.isCyclic(8));
+
+  ocgl::algorithm::CandidateDomains<TypeParam, TypeParam> shared;
+  for (const auto &gs : {"*1**1", "**(*)*", "*1*****1*", "*"}) {
+    auto query = ocgl::GraphStringParser<TypeParam>::parse(gs);
+    shared.setQuery(query);
+    shared.compute(graph, data);
+
+    ocgl::algorithm::CandidateDomains<TypeParam, TypeParam> domains(query);
+    domains.compute(graph);
+
+    EXPECT_EQ(domains.isEmpty(), shared.isEmpty());
+    for (unsigned int u = 0; u < ocgl::numVertices(query); ++u)
+      EXPECT_EQ(domain(domains, u), domain(shared, u));
+  }
+}
+
+TYPED_TEST(CandidateDomainsTest, Refine)
+{
+  using Vertex = typename ocgl::GraphTraits<TypeParam>::Vertex;
+
+  // query vertex 0 needs a neighbour with label 1
+  auto query = ocgl::GraphStringParser<TypeParam>::parse("**");
+  auto graph = ocgl::GraphStringParser<TypeParam>::parse("****");
+  auto vertexMatcher = [&] (Vertex u, Vertex v) {
+    auto ui = ocgl::getVertexIndex(query, u);
+    auto vi = ocgl::getVertexIndex(graph, v);
+    return ui == 0 || vi == 3;
+  };
+
+  ocgl::algorithm::CandidateDomains<TypeParam, TypeParam> domains(query);
+  domains.compute(graph, vertexMatcher, ocgl::algorithm::impl::AlwaysMatch(),
+      false);
+  EXPECT_EQ(std::vector<unsigned int>({0, 1, 2, 3}), domain(domains, 0));
+  EXPECT_EQ(std::vector<unsigned int>({3}), domain(domains, 1));
+
+  domains.compute(graph, vertexMatcher);
+  EXPECT_EQ(std::vector<unsigned int>({2}), domain(domains, 0));
+  EXPECT_EQ(std::vector<unsigned int>({3}), domain(domains, 1));
+}
+
+TYPED_TEST(CandidateDomainsTest, Large)
+{
+  // more than one block per domain
+  auto query = ocgl::GraphStringParser<TypeParam>::parse("*1**1");
+  std::string gs = "*1**1";
+  for (int i = 0; i < 100; ++i)
+    gs += "*";
+  gs += "1**1";
+  auto graph = ocgl::GraphStringParser<TypeParam>::parse(gs);
+
+  ocgl::algorithm::CandidateDomains<TypeParam, TypeParam> domains(query);
+  domains.compute(graph);
+
+  auto n = ocgl::numVertices(graph);
+  EXPECT_EQ(std::vector<unsigned int>({0, 1, 2, n - 3, n - 2, n - 1}),
+      domain(domains, 0));
+}
+
+TYPED_TEST(CandidateDomainsTest, Search)
+{
+  std::vector<std::string> queryGS = {
+    "*", "**", "**(*)*", "*1**1", "*1***1", "*1*****1", "*1***2**12",
+    "**1***1"
+  };
+  std::vector<std::string> graphGS = {
+    "", "*", "*****", "*1*****1", "*1*****1**(*)*", "*1***2*****2*1",
+    "*1**1.*1**1", "*1***2**12"
+  };
+
+  for (const auto &qgs : queryGS) {
+    auto query = ocgl::GraphStringParser<TypeParam>::parse(qgs);
+    ocgl::algorithm::MatchPlan<TypeParam> plan(query);
+    ocgl::algorithm::CandidateDomains<TypeParam, TypeParam> domains(query);
+
+    for (const auto &ggs : graphGS) {
+      auto graph = ocgl::GraphStringParser<TypeParam>::parse(ggs);
+      domains.compute(graph);
+
+      ocgl::algorithm::IsomorphismSearch<TypeParam, TypeParam> search(plan,
+          graph);
+      search.setDomains(domains);
+      std::size_t count = 0;
+      while (search.next())
+        ++count;
+
+      EXPECT_EQ(ocgl::algorithm::countIsomorphisms(query, graph), count)
+        << qgs << " in " << ggs;
+    }
+  }
+}
+
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
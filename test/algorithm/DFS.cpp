@@ -1,4 +1,6 @@
 #include <ocgl/algorithm/DFS.h>
+#include <ocgl/algorithm/ConnectedComponents.h>
+#include <ocgl/algorithm/CycleMembership.h>
 
 #include "../test.h"
 
@@ -172,6 +174,151 @@ TYPED_TEST(DFSTest, SingleComponent)
   EXPECT_EQ(correct.str(), trace);
 }
 
+TYPED_TEST(DFSTest, Branches)
+{
+  auto trace = dfsTraceGraph<TypeParam>("*1*(*)**1*");
+
+  std::stringstream correct;
+  correct << "initialize()" << std::endl
+          << "component(0)" << std::endl
+          << "vertex(0)" << std::endl
+          << "edge(0)" << std::endl
+          << "vertex(1)" << std::endl
+          << "edge(1)" << std::endl
+          << "vertex(2)" << std::endl
+          << "finishVertex(2)" << std::endl
+          << "finishEdge(1)" << std::endl
+          << "edge(2)" << std::endl
+          << "vertex(3)" << std::endl
+          << "edge(3)" << std::endl
+          << "vertex(4)" << std::endl
+          << "backEdge(4)" << std::endl
+          << "edge(5)" << std::endl
+          << "vertex(5)" << std::endl
+          << "finishVertex(5)" << std::endl
+          << "finishEdge(5)" << std::endl
+          << "finishVertex(4)" << std::endl
+          << "finishEdge(3)" << std::endl
+          << "finishVertex(3)" << std::endl
+          << "finishEdge(2)" << std::endl
+          << "finishVertex(1)" << std::endl
+          << "finishEdge(0)" << std::endl
+          << "finishVertex(0)" << std::endl;
+
+  EXPECT_EQ(correct.str(), trace);
+}
+
+TYPED_TEST(DFSTest, LongChain)
+{
+  // a recursive DFS would overflow the stack
+  const unsigned int n = 1000000;
+  TypeParam g;
+  auto prev = ocgl::addVertex(g);
+  for (unsigned int i = 1; i < n; ++i) {
+    auto v = ocgl::addVertex(g);
+    ocgl::addEdge(g, prev, v);
+    prev = v;
+  }
+
+  struct CountVisitor : public ocgl::algorithm::DFSVisitor<TypeParam>
+  {
+    void vertex(const TypeParam&, typename ocgl::GraphTraits<TypeParam>::Vertex)
+    {
+      ++numVertices;
+    }
+
+    void finishEdge(const TypeParam&, typename ocgl::GraphTraits<TypeParam>::Edge)
+    {
+      ++numFinishedEdges;
+    }
+
+    unsigned int numVertices = 0;
+    unsigned int numFinishedEdges = 0;
+  } visitor;
+
+  ocgl::algorithm::dfs(g, visitor);
+  EXPECT_EQ(n, visitor.numVertices);
+  EXPECT_EQ(n - 1, visitor.numFinishedEdges);
+}
+
+TYPED_TEST(DFSTest, Events)
+{
+  using Base = ocgl::algorithm::DFSVisitor<TypeParam>;
+  using Trace = DFSVisitor<TypeParam>;
+
+  // the empty events of the base class are not implemented
+  EXPECT_FALSE((ocgl::algorithm::impl::HasVertexEvent<TypeParam, Base>::value));
+  EXPECT_FALSE((ocgl::algorithm::impl::HasBackEdgeEvent<TypeParam, Base>::value));
+  EXPECT_TRUE((ocgl::algorithm::impl::HasInitializeEvent<TypeParam, Trace>::value));
+  EXPECT_TRUE((ocgl::algorithm::impl::HasComponentEvent<TypeParam, Trace>::value));
+  EXPECT_TRUE((ocgl::algorithm::impl::HasVertexEvent<TypeParam, Trace>::value));
+  EXPECT_TRUE((ocgl::algorithm::impl::HasBackEdgeEvent<TypeParam, Trace>::value));
+  EXPECT_TRUE((ocgl::algorithm::impl::HasFinishVertexEvent<TypeParam, Trace>::value));
+
+  // visitors do not have to inherit DFSVisitor
+  struct EdgeVisitor
+  {
+    void edge(const TypeParam&, typename ocgl::GraphTraits<TypeParam>::Edge)
+    {
+      ++numEdges;
+    }
+
+    unsigned int numEdges = 0;
+  } visitor;
+
+  EXPECT_TRUE((ocgl::algorithm::impl::HasEdgeEvent<TypeParam, EdgeVisitor>::value));
+  EXPECT_FALSE((ocgl::algorithm::impl::HasVertexEvent<TypeParam, EdgeVisitor>::value));
+  EXPECT_FALSE((ocgl::algorithm::impl::HasBackEdgeEvent<TypeParam, EdgeVisitor>::value));
+
+  // the tree edges are found without marking the edges
+  auto g = ocgl::GraphStringParser<TypeParam>::parse("*1***2*****2*1.**.*");
+  ocgl::algorithm::dfs(g, visitor);
+  EXPECT_EQ(ocgl::numVertices(g) - 3, visitor.numEdges);
+}
+
+TYPED_TEST(DFSTest, Composite)
+{
+  auto g = ocgl::GraphStringParser<TypeParam>::parse("*1*(*)**1*.**");
+
+  std::stringstream ss1, ss2;
+  DFSVisitor<TypeParam> trace1(ss1), trace2(ss2);
+  auto visitor = ocgl::algorithm::combineDFSVisitors(trace1, trace2);
+  ocgl::algorithm::dfs(g, visitor);
+
+  std::stringstream correct;
+  DFSVisitor<TypeParam> trace(correct);
+  ocgl::algorithm::dfs(g, trace);
+
+  EXPECT_EQ(correct.str(), ss1.str());
+  EXPECT_EQ(correct.str(), ss2.str());
+}
+
+TYPED_TEST(DFSTest, CompositeAnalyses)
+{
+  auto g = ocgl::GraphStringParser<TypeParam>::parse("*1*****1**(*)*.*1**1.*");
+
+  // three analyses in a single pass
+  ocgl::VertexEdgePropertyMap<TypeParam, bool> cyclic(g);
+  ocgl::VertexEdgePropertyMap<TypeParam, unsigned int> components(g);
+  ocgl::algorithm::impl::CycleMembershipDFSVisitor<TypeParam> cyclicVisitor(cyclic);
+  ocgl::algorithm::impl::ConnectedComponentsDFSVisitor<TypeParam> componentsVisitor(components);
+  ocgl::algorithm::impl::NumConnectedComponentsDFSVisitor<TypeParam> countVisitor;
+
+  auto visitor = ocgl::algorithm::combineDFSVisitors(cyclicVisitor,
+      componentsVisitor, countVisitor);
+  using Visitor = decltype(visitor);
+  EXPECT_TRUE((ocgl::algorithm::impl::HasBackEdgeEvent<TypeParam, Visitor>::value));
+  EXPECT_FALSE((ocgl::algorithm::impl::HasFinishEdgeEvent<TypeParam, Visitor>::value));
+
+  ocgl::algorithm::dfs(g, visitor);
+
+  EXPECT_EQ(ocgl::algorithm::cycleMembership(g).vertices.map(), cyclic.vertices.map());
+  EXPECT_EQ(ocgl::algorithm::cycleMembership(g).edges.map(), cyclic.edges.map());
+  EXPECT_EQ(ocgl::algorithm::connectedComponents(g).vertices.map(), components.vertices.map());
+  EXPECT_EQ(ocgl::algorithm::connectedComponents(g).edges.map(), components.edges.map());
+  EXPECT_EQ(3, countVisitor.numComponents);
+}
+
 int main(int argc, char **argv)
 {
   ::testing::InitGoogleTest(&argc, argv);
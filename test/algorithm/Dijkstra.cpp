@@ -138,6 +138,43 @@ TYPED_TEST(DijkstraTest, Dijkstra)
   EXPECT_EQ(V[0], path[3]);
 }
 
+TYPED_TEST(DijkstraTest, Weights)
+{
+  using Graph = TypeParam;
+  using Vertex = typename ocgl::GraphTraits<Graph>::Vertex;
+
+  //      e0     e1
+  //  v0 ---- v1 ---- v2
+  //   \              /
+  //    ------ v3 ----
+  //      e3      e2
+  auto g = ocgl::GraphStringParser<Graph>::parse("*1***1");
+  auto V = ocgl::getVertices(g).toVector();
+  auto E = ocgl::getEdges(g).toVector();
+
+  ocgl::EdgePropertyMap<Graph, unsigned int> weights(g, 1);
+  weights[E[0]] = 5;
+
+  ocgl::algorithm::Dijkstra<Graph> d(g, V[0], weights);
+
+  EXPECT_EQ(0, d.distance(V[0]));
+  EXPECT_EQ(3, d.distance(V[1]));
+  EXPECT_EQ(2, d.distance(V[2]));
+  EXPECT_EQ(1, d.distance(V[3]));
+
+  EXPECT_EQ(std::vector<Vertex>({V[0], V[3], V[2], V[1]}), d.path(V[1]));
+
+  // masked
+  ocgl::VertexPropertyMap<Graph, bool> mask(g, true);
+  mask[V[2]] = false;
+
+  ocgl::algorithm::Dijkstra<Graph> masked(g, V[0], mask, weights);
+
+  EXPECT_EQ(5, masked.distance(V[1]));
+  EXPECT_EQ(masked.infinity(), masked.distance(V[2]));
+  EXPECT_EQ(1, masked.distance(V[3]));
+}
+
 int main(int argc, char **argv)
 {
   ::testing::InitGoogleTest(&argc, argv);
@@ -1,5 +1,7 @@
 #include <ocgl/algorithm/Isomorphisms.h>
 
+#include <atomic>
+
 #include "../test.h"
 
 GRAPH_TYPED_TEST(IsomorphismsTest);
@@ -67,9 +69,407 @@ TYPED_TEST(IsomorphismsTest, CountIsomorphisms)
   EXPECT_EQ(200, countIsomorphisms<TypeParam>("*12*3*4*5*16.*2345623456.*12*3*4*5*16"));
 }
 
+TYPED_TEST(IsomorphismsTest, Matchers)
+{
+  using Vertex = typename ocgl::GraphTraits<TypeParam>::Vertex;
+  using Edge = typename ocgl::GraphTraits<TypeParam>::Edge;
+
+  auto query = ocgl::GraphStringParser<TypeParam>::parse("**");
+  auto graph = ocgl::GraphStringParser<TypeParam>::parse("***");
+
+  int count = 0;
+  auto visitor = [&count] (const ocgl::VertexPropertyMap<TypeParam, Vertex>&) {
+    ++count;
+    return false;
+  };
+
+  // query vertex 0 can only be mapped to the center
+  auto vertexMatcher = [&] (Vertex u, Vertex v) {
+    return ocgl::getVertexIndex(query, u) || ocgl::getDegree(graph, v) == 2;
+  };
+  ocgl::algorithm::isomorphisms(query, graph, visitor, vertexMatcher);
+  EXPECT_EQ(2, count);
+
+  // graph edge 0 can not be used
+  count = 0;
+  auto edgeMatcher = [&] (Edge, Edge e) {
+    return ocgl::getEdgeIndex(graph, e) != 0;
+  };
+  ocgl::algorithm::isomorphisms(query, graph, visitor,
+      ocgl::algorithm::impl::AlwaysMatch(), edgeMatcher);
+  EXPECT_EQ(2, count);
+}
+
+TYPED_TEST(IsomorphismsTest, MappingView)
+{
+  auto query = ocgl::GraphStringParser<TypeParam>::parse("**(*)*");
+  auto graph = ocgl::GraphStringParser<TypeParam>::parse("**(*)(*)*");
+
+  int count = 0;
+  ocgl::algorithm::isomorphismMappings(query, graph,
+      [&] (const ocgl::algorithm::MappingView<TypeParam, TypeParam> &mapping) {
+        EXPECT_EQ(4, mapping.size());
+        // the center is always mapped to the center
+        EXPECT_EQ(ocgl::getVertex(graph, 1), mapping[ocgl::getVertex(query, 1)]);
+        auto map = mapping.toPropertyMap();
+        for (auto u : ocgl::getVertices(query))
+          EXPECT_EQ(mapping[u], map[u]);
+        ++count;
+        return false;
+      });
+
+  EXPECT_EQ(24, count);
+}
+
+TYPED_TEST(IsomorphismsTest, CountOnly)
+{
+  auto count = [] (const std::string &queryGS, const std::string &graphGS) {
+    auto query = ocgl::GraphStringParser<TypeParam>::parse(queryGS);
+    auto graph = ocgl::GraphStringParser<TypeParam>::parse(graphGS);
+    return ocgl::algorithm::countIsomorphisms(query, graph);
+  };
+
+  EXPECT_EQ(0, count("*", ""));
+  EXPECT_EQ(12, count("****", "*1***1*"));
+  EXPECT_EQ(200, count("*1****1.*.*1****1", "*1****1.*.*1****1"));
+}
+
+TYPED_TEST(IsomorphismsTest, FirstMatch)
+{
+  using Vertex = typename ocgl::GraphTraits<TypeParam>::Vertex;
+
+  auto query = ocgl::GraphStringParser<TypeParam>::parse("*1***1");
+  auto ring = ocgl::GraphStringParser<TypeParam>::parse("*1****1");
+  auto chain = ocgl::GraphStringParser<TypeParam>::parse("*****");
+
+  EXPECT_TRUE(ocgl::algorithm::hasIsomorphism(query, query));
+  EXPECT_FALSE(ocgl::algorithm::hasIsomorphism(query, ring));
+  EXPECT_FALSE(ocgl::algorithm::hasIsomorphism(query, chain));
+
+  ocgl::VertexPropertyMap<TypeParam, Vertex> solution(query);
+  EXPECT_FALSE(ocgl::algorithm::firstIsomorphism(query, chain, solution));
+  EXPECT_TRUE(ocgl::algorithm::firstIsomorphism(query, query, solution));
+  for (auto e : ocgl::getEdges(query))
+    EXPECT_TRUE(ocgl::isValidEdge(query, ocgl::getEdge(query,
+            solution[ocgl::getSource(query, e)],
+            solution[ocgl::getTarget(query, e)])));
+}
+
+TYPED_TEST(IsomorphismsTest, ResumableSearch)
+{
+  auto query = ocgl::GraphStringParser<TypeParam>::parse("*1****1");
+  auto graph = ocgl::GraphStringParser<TypeParam>::parse("*1****1.*.*1****1");
+
+  ocgl::algorithm::IsomorphismSearch<TypeParam, TypeParam> search(query, graph);
+
+  std::size_t count = 0;
+  while (search.next()) {
+    auto mapping = search.mapping();
+    for (auto e : ocgl::getEdges(query))
+      EXPECT_TRUE(ocgl::isValidEdge(graph, ocgl::getEdge(graph,
+              mapping[ocgl::getSource(query, e)],
+              mapping[ocgl::getTarget(query, e)])));
+    ++count;
+  }
+
+  EXPECT_EQ(20, count);
+  EXPECT_EQ(count, ocgl::algorithm::countIsomorphisms(query, graph));
+  EXPECT_FALSE(search.aborted());
+  EXPECT_FALSE(search.next());
+}
+
+TYPED_TEST(IsomorphismsTest, NodeLimit)
+{
+  auto query = ocgl::GraphStringParser<TypeParam>::parse("*1****1");
+  auto graph = ocgl::GraphStringParser<TypeParam>::parse("*1****1.*.*1****1");
+
+  ocgl::algorithm::IsomorphismSearch<TypeParam, TypeParam> search(query, graph);
+  search.setLimits(10);
+
+  std::size_t count = 0;
+  while (search.next())
+    ++count;
+
+  EXPECT_TRUE(search.aborted());
+  EXPECT_EQ(10, search.numNodes());
+  EXPECT_LT(count, 20);
+}
+
+TYPED_TEST(IsomorphismsTest, DeepQuery)
+{
+  using Vertex = typename ocgl::GraphTraits<TypeParam>::Vertex;
+
+  // a long path would overflow the stack with a recursive search
+  TypeParam path;
+  auto prev = ocgl::addVertex(path);
+  for (int i = 1; i < 100000; ++i) {
+    auto v = ocgl::addVertex(path);
+    ocgl::addEdge(path, prev, v);
+    prev = v;
+  }
+
+  // start at vertex 0 which can only be mapped to itself
+  ocgl::VertexPropertyMap<TypeParam, unsigned int> frequency(path, 2);
+  frequency[ocgl::getVertex(path, 0)] = 1;
+  ocgl::algorithm::MatchPlan<TypeParam> plan(path, frequency);
+  auto vertexMatcher = [&path] (Vertex u, Vertex v) {
+    return ocgl::getVertexIndex(path, u) || !ocgl::getVertexIndex(path, v);
+  };
+
+  EXPECT_EQ(1, ocgl::algorithm::countIsomorphisms(plan, path, vertexMatcher));
+}
+
+TYPED_TEST(IsomorphismsTest, Parallel)
+{
+  using Vertex = typename ocgl::GraphTraits<TypeParam>::Vertex;
+
+  std::vector<std::pair<std::string, std::string>> pairs = {
+    {"*", ""}, {"*", "***"}, {"**", "*1**1"}, {"*.*", "***"},
+    {"**(*)*", "**(*)(*)*"}, {"*1***1", "****"}, {"****", "*1***1*"},
+    {"*1****1", "*1****1.*.*1****1"},
+    {"*1****1.*.*1****1", "*1****1.*.*1****1"}
+  };
 
+  for (const auto &pair : pairs) {
+    auto query = ocgl::GraphStringParser<TypeParam>::parse(pair.first);
+    auto graph = ocgl::GraphStringParser<TypeParam>::parse(pair.second);
+    auto expected = ocgl::algorithm::countIsomorphisms(query, graph);
 
+    for (unsigned int numThreads = 1; numThreads <= 4; ++numThreads) {
+      EXPECT_EQ(expected, ocgl::algorithm::countIsomorphismsParallel(query,
+            graph, numThreads));
+      EXPECT_EQ(expected > 0, ocgl::algorithm::hasIsomorphismParallel(query,
+            graph, numThreads));
+
+      // collect the mappings per thread
+      std::vector<std::vector<std::vector<Vertex>>> mappings(numThreads);
+      ocgl::algorithm::isomorphismsParallel(query, graph,
+          [&] (const ocgl::algorithm::MappingView<TypeParam, TypeParam> &mapping,
+            unsigned int thread) {
+            std::vector<Vertex> m;
+            for (auto u : ocgl::getVertices(query))
+              m.push_back(mapping[u]);
+            mappings[thread].push_back(m);
+            return false;
+          }, numThreads);
+
+      std::size_t count = 0;
+      for (const auto &threadMappings : mappings)
+        count += threadMappings.size();
+      EXPECT_EQ(expected, count);
+    }
+  }
+}
 
+TYPED_TEST(IsomorphismsTest, ParallelStop)
+{
+  auto query = ocgl::GraphStringParser<TypeParam>::parse("*1****1");
+  auto graph = ocgl::GraphStringParser<TypeParam>::parse("*1****1.*.*1****1");
+
+  // each thread stops after its first match at most
+  std::atomic<int> count(0);
+  ocgl::algorithm::isomorphismsParallel(query, graph,
+      [&count] (const ocgl::algorithm::MappingView<TypeParam, TypeParam>&,
+        unsigned int) {
+        ++count;
+        return true;
+      }, 4);
+
+  EXPECT_GE(count, 1);
+  EXPECT_LE(count, 4);
+}
+
+TYPED_TEST(IsomorphismsTest, Batch)
+{
+  auto query = ocgl::GraphStringParser<TypeParam>::parse("*1****1");
+  ocgl::algorithm::MatchPlan<TypeParam> plan(query);
+
+  std::vector<std::string> graphGS = {
+    "", "*1****1", "*1*****1", "*1****1.*.*1****1", "******", "*1***2**12",
+    "*1*****1*1****1"
+  };
+
+  std::vector<TypeParam> targets;
+  for (int i = 0; i < 10; ++i)
+    for (const auto &gs : graphGS)
+      targets.push_back(ocgl::GraphStringParser<TypeParam>::parse(gs));
+
+  for (unsigned int numThreads = 1; numThreads <= 4; ++numThreads) {
+    auto counts = ocgl::algorithm::countIsomorphismsBatch(plan, targets,
+        numThreads);
+    auto hits = ocgl::algorithm::hasIsomorphismBatch(query, targets,
+        numThreads);
+    auto solutions = ocgl::algorithm::firstIsomorphismBatch(plan, targets,
+        numThreads);
+
+    ASSERT_EQ(targets.size(), counts.size());
+    ASSERT_EQ(targets.size(), hits.size());
+    ASSERT_EQ(targets.size(), solutions.size());
+
+    for (std::size_t i = 0; i < targets.size(); ++i) {
+      EXPECT_EQ(ocgl::algorithm::countIsomorphisms(query, targets[i]),
+          counts[i]);
+      EXPECT_EQ(counts[i] > 0, hits[i] == 1);
+
+      auto u = ocgl::getVertex(query, 0);
+      EXPECT_EQ(counts[i] > 0, ocgl::isValidVertex(targets[i], solutions[i][u]));
+    }
+  }
+}
+
+TYPED_TEST(IsomorphismsTest, Screen)
+{
+  using Screen = ocgl::algorithm::SubgraphScreen;
+
+  auto query = ocgl::GraphStringParser<TypeParam>::parse("*1****1");
+  ocgl::algorithm::MatchPlan<TypeParam> plan(query);
+
+  auto ring = ocgl::GraphStringParser<TypeParam>::parse("*1****1");
+  auto chain = ocgl::GraphStringParser<TypeParam>::parse("******");
+  auto smallRing = ocgl::GraphStringParser<TypeParam>::parse("*1***1**");
+  auto path = ocgl::GraphStringParser<TypeParam>::parse("**");
+
+  Screen screen;
+  EXPECT_EQ(10, ocgl::algorithm::countIsomorphisms(plan, ring, screen));
+  EXPECT_EQ(0, ocgl::algorithm::countIsomorphisms(plan, chain, screen));
+  EXPECT_FALSE(ocgl::algorithm::hasIsomorphism(plan, smallRing, screen));
+  EXPECT_FALSE(ocgl::algorithm::hasIsomorphism(plan, path, screen));
+
+  EXPECT_EQ(4, screen.numTested());
+  EXPECT_EQ(1, screen.numPassed());
+  EXPECT_EQ(1, screen.numRejected(Screen::VertexCount));
+  EXPECT_EQ(1, screen.numRejected(Screen::DegreeSequence));
+  EXPECT_EQ(1, screen.numRejected(Screen::CycleCount));
+
+  // a rejected graph is not searched
+  screen.addTest([] (const ocgl::algorithm::SubgraphInvariants&,
+        const ocgl::algorithm::SubgraphInvariants&) {
+    return false;
+  });
+  std::size_t count = 0;
+  ocgl::algorithm::isomorphisms(plan, ring, [&count] (
+        const ocgl::VertexPropertyMap<TypeParam,
+        typename ocgl::GraphTraits<TypeParam>::Vertex>&) {
+    ++count;
+    return false;
+  }, screen);
+  EXPECT_EQ(0, count);
+  EXPECT_EQ(1, screen.numRejected(Screen::Custom));
+}
+
+TYPED_TEST(IsomorphismsTest, BatchScreen)
+{
+  using Screen = ocgl::algorithm::SubgraphScreen;
+
+  auto query = ocgl::GraphStringParser<TypeParam>::parse("*1****1");
+  ocgl::algorithm::MatchPlan<TypeParam> plan(query);
+
+  std::vector<std::string> graphGS = {
+    "", "*1****1", "*1*****1", "******", "*1***1**", "*1****1.*.*1****1"
+  };
+
+  std::vector<TypeParam> targets;
+  for (int i = 0; i < 10; ++i)
+    for (const auto &gs : graphGS)
+      targets.push_back(ocgl::GraphStringParser<TypeParam>::parse(gs));
+
+  Screen expected;
+  for (const auto &target : targets)
+    ocgl::algorithm::hasIsomorphism(plan, target, expected);
+
+  for (unsigned int numThreads = 1; numThreads <= 4; ++numThreads) {
+    // the counters of all threads are added
+    Screen screen;
+    auto counts = ocgl::algorithm::countIsomorphismsBatch(plan, targets,
+        screen, numThreads);
+    ASSERT_EQ(targets.size(), counts.size());
+
+    EXPECT_EQ(targets.size(), screen.numTested());
+    for (int test = 0; test < Screen::NumTests; ++test)
+      EXPECT_EQ(expected.numRejected(static_cast<Screen::Test>(test)),
+          screen.numRejected(static_cast<Screen::Test>(test)));
+  }
+}
+
+TYPED_TEST(IsomorphismsTest, LabelScreen)
+{
+  using Screen = ocgl::algorithm::SubgraphScreen;
+  using Vertex = typename ocgl::GraphTraits<TypeParam>::Vertex;
+
+  auto query = ocgl::GraphStringParser<TypeParam>::parse("***");
+  auto graph = ocgl::GraphStringParser<TypeParam>::parse("*****");
+
+  // all query vertices have label 1, only 2 graph vertices have label 1
+  auto queryLabel = [] (Vertex) { return 1u; };
+  auto graphLabel = [&] (Vertex v) {
+    return ocgl::getVertexIndex(graph, v) < 2 ? 1u : 0u;
+  };
+  auto vertexMatcher = [&] (Vertex, Vertex v) { return graphLabel(v) == 1; };
+
+  ocgl::algorithm::MatchPlan<TypeParam> plan(query);
+  plan.computeLabels(queryLabel);
+
+  Screen screen;
+  EXPECT_EQ(0, ocgl::algorithm::countIsomorphisms(plan, graph, graphLabel,
+        screen, vertexMatcher));
+  EXPECT_FALSE(ocgl::algorithm::hasIsomorphism(plan, graph, graphLabel,
+        screen, vertexMatcher));
+  EXPECT_EQ(2, screen.numRejected(Screen::LabelHistogram));
+
+  // 3 graph vertices with label 1
+  auto moreLabels = [&] (Vertex v) {
+    return ocgl::getVertexIndex(graph, v) < 3 ? 1u : 0u;
+  };
+  auto moreMatcher = [&] (Vertex, Vertex v) { return moreLabels(v) == 1; };
+  EXPECT_EQ(2, ocgl::algorithm::countIsomorphisms(plan, graph, moreLabels,
+        screen, moreMatcher));
+  EXPECT_EQ(2, screen.numRejected(Screen::LabelHistogram));
+  EXPECT_EQ(1, screen.numPassed());
+
+  // without target labels, the histograms are not compared
+  EXPECT_EQ(0, ocgl::algorithm::countIsomorphisms(plan, graph, screen,
+        vertexMatcher));
+  EXPECT_EQ(2, screen.numRejected(Screen::LabelHistogram));
+  EXPECT_EQ(2, screen.numPassed());
+}
+
+TYPED_TEST(IsomorphismsTest, ParallelScreen)
+{
+  using Screen = ocgl::algorithm::SubgraphScreen;
+
+  auto query = ocgl::GraphStringParser<TypeParam>::parse("*1****1");
+  ocgl::algorithm::MatchPlan<TypeParam> plan(query);
+
+  auto ring = ocgl::GraphStringParser<TypeParam>::parse("*1****1");
+  auto smallRing = ocgl::GraphStringParser<TypeParam>::parse("*1***1**");
+
+  for (unsigned int numThreads = 1; numThreads <= 4; ++numThreads) {
+    Screen screen;
+    EXPECT_EQ(10, ocgl::algorithm::countIsomorphismsParallel(plan, ring,
+          screen, numThreads));
+    EXPECT_FALSE(ocgl::algorithm::hasIsomorphismParallel(plan, smallRing,
+          screen, numThreads));
+
+    // the graph is screened once, not in every thread
+    EXPECT_EQ(2, screen.numTested());
+    EXPECT_EQ(1, screen.numRejected(Screen::CycleCount));
+
+    // a rejected graph is not searched
+    screen.addTest([] (const ocgl::algorithm::SubgraphInvariants&,
+          const ocgl::algorithm::SubgraphInvariants&) {
+      return false;
+    });
+    std::size_t count = 0;
+    ocgl::algorithm::isomorphismsParallel(plan, ring, [&count] (
+          const ocgl::algorithm::MappingView<TypeParam, TypeParam>&,
+          unsigned int) {
+      ++count;
+      return false;
+    }, screen, numThreads);
+    EXPECT_EQ(0, count);
+    EXPECT_EQ(1, screen.numRejected(Screen::Custom));
+  }
+}
 
 int main(int argc, char **argv)
 {
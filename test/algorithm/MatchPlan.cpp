@@ -0,0 +1,137 @@
+#include <ocgl/algorithm/MatchPlan.h>
+#include <ocgl/algorithm/Isomorphisms.h>
+
+#include "../test.h"
+
+GRAPH_TYPED_TEST(MatchPlanTest);
+
+template<typename Graph>
+std::vector<unsigned int> planOrder(const ocgl::algorithm::MatchPlan<Graph> &plan)
+{
+  std::vector<unsigned int> order;
+  for (unsigned int d = 0; d < plan.size(); ++d)
+    order.push_back(ocgl::getVertexIndex(plan.query(), plan.vertex(d)));
+  return order;
+}
+
+TYPED_TEST(MatchPlanTest, Order)
+{
+  auto g = ocgl::GraphStringParser<TypeParam>::parse("**(*)*");
+  ocgl::algorithm::MatchPlan<TypeParam> plan(g);
+
+  // the vertex with the highest degree is first
+  EXPECT_EQ(4, plan.size());
+  EXPECT_EQ(std::vector<unsigned int>({1, 0, 2, 3}), planOrder(plan));
+
+  EXPECT_FALSE(ocgl::isValidVertex(g, plan.parent(0)));
+  for (unsigned int d = 1; d < plan.size(); ++d) {
+    EXPECT_EQ(ocgl::getVertex(g, 1), plan.parent(d));
+    EXPECT_EQ(1, plan.checks(d).size());
+    EXPECT_EQ(d, plan.depth(plan.vertex(d)));
+  }
+  EXPECT_EQ(0, plan.checks(0).size());
+}
+
+TYPED_TEST(MatchPlanTest, Empty)
+{
+  ocgl::algorithm::MatchPlan<TypeParam> plan;
+  EXPECT_EQ(0, plan.size());
+
+  // a state constructed from a query owns its plan
+  auto g = ocgl::GraphStringParser<TypeParam>::parse("**(*)*");
+  ocgl::algorithm::impl::VF2State<TypeParam, TypeParam> state(g, g);
+  EXPECT_EQ(&g, &state.plan().query());
+  EXPECT_EQ(std::vector<unsigned int>({1, 0, 2, 3}), planOrder(state.plan()));
+}
+
+TYPED_TEST(MatchPlanTest, Invariants)
+{
+  auto g = ocgl::GraphStringParser<TypeParam>::parse("*1***1*");
+  ocgl::algorithm::MatchPlan<TypeParam> plan(g);
+
+  // the counts are computed with the plan
+  const auto &invariants = plan.invariants();
+  EXPECT_EQ(5, invariants.numVertices());
+  EXPECT_EQ(5, invariants.numEdges());
+  EXPECT_FALSE(invariants.hasCycles());
+  EXPECT_FALSE(invariants.hasLabels());
+
+  // the cycles and labels only on request
+  plan.computeCycles();
+  EXPECT_TRUE(invariants.hasCycles());
+  EXPECT_EQ(4, invariants.numCyclicVertices());
+  EXPECT_EQ(4, invariants.numCyclicEdges());
+
+  plan.computeLabels([] (unsigned int v) { return v % 2; });
+  EXPECT_TRUE(invariants.hasLabels());
+  EXPECT_EQ(3, invariants.numVerticesWithLabel(0));
+  EXPECT_EQ(2, invariants.numVerticesWithLabel(1));
+}
+
+TYPED_TEST(MatchPlanTest, Ring)
+{
+  auto g = ocgl::GraphStringParser<TypeParam>::parse("*1***1");
+  ocgl::algorithm::MatchPlan<TypeParam> plan(g);
+
+  EXPECT_EQ(std::vector<unsigned int>({0, 1, 2, 3}), planOrder(plan));
+
+  // the last vertex closes the ring
+  EXPECT_EQ(ocgl::getVertex(g, 0), plan.parent(3));
+  EXPECT_EQ(2, plan.checks(3).size());
+  for (const auto &check : plan.checks(3))
+    EXPECT_EQ(check.edge, ocgl::getEdge(g, check.vertex, plan.vertex(3)));
+}
+
+TYPED_TEST(MatchPlanTest, Frequency)
+{
+  auto g = ocgl::GraphStringParser<TypeParam>::parse("***");
+
+  ocgl::algorithm::MatchPlan<TypeParam> plan1(g);
+  EXPECT_EQ(std::vector<unsigned int>({1, 0, 2}), planOrder(plan1));
+
+  // rare vertices are matched first
+  ocgl::VertexPropertyMap<TypeParam, unsigned int> frequency(g, 5);
+  frequency[ocgl::getVertex(g, 2)] = 1;
+  ocgl::algorithm::MatchPlan<TypeParam> plan2(g, frequency);
+  EXPECT_EQ(std::vector<unsigned int>({2, 1, 0}), planOrder(plan2));
+}
+
+TYPED_TEST(MatchPlanTest, Components)
+{
+  auto g = ocgl::GraphStringParser<TypeParam>::parse("*.**");
+  ocgl::algorithm::MatchPlan<TypeParam> plan(g);
+
+  EXPECT_EQ(std::vector<unsigned int>({1, 2, 0}), planOrder(plan));
+  EXPECT_FALSE(ocgl::isValidVertex(g, plan.parent(0)));
+  EXPECT_EQ(ocgl::getVertex(g, 1), plan.parent(1));
+  EXPECT_FALSE(ocgl::isValidVertex(g, plan.parent(2)));
+}
+
+TYPED_TEST(MatchPlanTest, Reuse)
+{
+  using Vertex = typename ocgl::GraphTraits<TypeParam>::Vertex;
+
+  auto query = ocgl::GraphStringParser<TypeParam>::parse("**(*)*");
+  ocgl::algorithm::MatchPlan<TypeParam> plan(query);
+
+  auto count = [&plan] (const std::string &graphGS) {
+    auto graph = ocgl::GraphStringParser<TypeParam>::parse(graphGS);
+    int n = 0;
+    ocgl::algorithm::isomorphisms(plan, graph,
+        [&n] (const ocgl::VertexPropertyMap<TypeParam, Vertex>&) {
+          ++n;
+          return false;
+        });
+    return n;
+  };
+
+  EXPECT_EQ(6, count("**(*)*"));
+  EXPECT_EQ(24, count("**(*)(*)*"));
+  EXPECT_EQ(0, count("****"));
+}
+
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
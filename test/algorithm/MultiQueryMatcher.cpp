@@ -0,0 +1,142 @@
+#include <ocgl/algorithm/MultiQueryMatcher.h>
+#include <ocgl/algorithm/Isomorphisms.h>
+
+#include "../test.h"
+
+GRAPH_TYPED_TEST(MultiQueryMatcherTest);
+
+TYPED_TEST(MultiQueryMatcherTest, Match)
+{
+  std::vector<std::string> queryGS = {
+    "*", "**", "***", "**(*)*", "*1**1", "*1***1", "*1*****1", "*1***2**12",
+    "*.*"
+  };
+  std::vector<std::string> targetGS = {
+    "", "*", "*****", "*1*****1", "*1*****1**(*)*", "*1***2*****2*1",
+    "*1**1.*1**1"
+  };
+
+  std::vector<TypeParam> queries;
+  for (const auto &gs : queryGS)
+    queries.push_back(ocgl::GraphStringParser<TypeParam>::parse(gs));
+
+  ocgl::algorithm::MultiQueryMatcher<TypeParam, TypeParam> matcher(queries);
+  EXPECT_EQ(queries.size(), matcher.numQueries());
+
+  std::vector<char> hits;
+  std::vector<std::size_t> counts;
+  for (const auto &gs : targetGS) {
+    auto target = ocgl::GraphStringParser<TypeParam>::parse(gs);
+
+    matcher.match(target, hits);
+    ASSERT_EQ(queries.size(), hits.size());
+    matcher.count(target, counts);
+    ASSERT_EQ(queries.size(), counts.size());
+
+    for (std::size_t i = 0; i < queries.size(); ++i) {
+      auto expected = ocgl::algorithm::countIsomorphisms(queries[i], target);
+      EXPECT_EQ(expected, counts[i]);
+      EXPECT_EQ(expected > 0, hits[i] == 1);
+      // the screen never rejects a query that matches
+      if (expected)
+        EXPECT_TRUE(matcher.mayMatch(i));
+    }
+  }
+
+  EXPECT_GT(matcher.numScreened(), 0);
+  EXPECT_GT(matcher.numSearched(), 0);
+  EXPECT_EQ(2 * queries.size() * targetGS.size(),
+      matcher.numScreened() + matcher.numSearched());
+}
+
+TYPED_TEST(MultiQueryMatcherTest, Screen)
+{
+  using Screen = ocgl::algorithm::SubgraphScreen;
+
+  std::vector<TypeParam> queries;
+  for (const auto &gs : {"***", "*1***1", "**(*)*", "********"})
+    queries.push_back(ocgl::GraphStringParser<TypeParam>::parse(gs));
+
+  ocgl::algorithm::MultiQueryMatcher<TypeParam, TypeParam> matcher(queries);
+  EXPECT_EQ(4, matcher.queryInvariants(1).numCyclicEdges());
+
+  std::vector<char> hits;
+  matcher.match(ocgl::GraphStringParser<TypeParam>::parse("******"), hits);
+  EXPECT_EQ(std::vector<char>({1, 0, 0, 0}), hits);
+  EXPECT_EQ(6, matcher.targetInvariants().numVertices());
+  EXPECT_TRUE(matcher.targetInvariants().hasCycles());
+
+  // only the first query is searched
+  EXPECT_EQ(1, matcher.numSearched());
+  EXPECT_EQ(3, matcher.numScreened());
+  EXPECT_EQ(1, matcher.screen().numRejected(Screen::VertexCount));
+  EXPECT_EQ(1, matcher.screen().numRejected(Screen::DegreeSequence));
+  EXPECT_EQ(1, matcher.screen().numRejected(Screen::CycleCount));
+}
+
+TYPED_TEST(MultiQueryMatcherTest, Domains)
+{
+  std::vector<TypeParam> queries;
+  for (const auto &gs : {"**(*)*", "*1**1", "*1***2**12", "**1***1"})
+    queries.push_back(ocgl::GraphStringParser<TypeParam>::parse(gs));
+
+  ocgl::algorithm::MultiQueryMatcher<TypeParam, TypeParam> matcher(queries);
+  matcher.setUseDomains(true);
+
+  std::vector<std::size_t> counts;
+  for (const auto &gs : {"*1*****1**(*)*", "*1***2*****2*1", "**(*)*.*1**1"}) {
+    auto target = ocgl::GraphStringParser<TypeParam>::parse(gs);
+    matcher.count(target, counts);
+    for (std::size_t i = 0; i < queries.size(); ++i)
+      EXPECT_EQ(ocgl::algorithm::countIsomorphisms(queries[i], target),
+          counts[i]);
+  }
+
+  // the 4-ring only passes the screen for the naphthalene
+  EXPECT_EQ(12, matcher.numScreened() + matcher.numSearched());
+}
+
+TYPED_TEST(MultiQueryMatcherTest, Labels)
+{
+  using Screen = ocgl::algorithm::SubgraphScreen;
+  using Vertex = typename ocgl::GraphTraits<TypeParam>::Vertex;
+
+  std::vector<TypeParam> queries;
+  for (const auto &gs : {"***", "**"})
+    queries.push_back(ocgl::GraphStringParser<TypeParam>::parse(gs));
+
+  ocgl::algorithm::MultiQueryMatcher<TypeParam, TypeParam> matcher(queries);
+  // only the first query is labelled (all vertices have label 1)
+  matcher.setQueryLabels(0, [] (Vertex) { return 1u; });
+  EXPECT_TRUE(matcher.queryInvariants(0).hasLabels());
+  EXPECT_FALSE(matcher.queryInvariants(1).hasLabels());
+
+  // only 2 target vertices have label 1
+  auto target = ocgl::GraphStringParser<TypeParam>::parse("*****");
+  matcher.setTarget(target, [&] (Vertex v) {
+    return ocgl::getVertexIndex(target, v) < 2 ? 1u : 0u;
+  });
+  EXPECT_TRUE(matcher.targetInvariants().hasLabels());
+
+  EXPECT_FALSE(matcher.hasMatch(0));
+  EXPECT_TRUE(matcher.hasMatch(1));
+  EXPECT_EQ(1, matcher.screen().numRejected(Screen::LabelHistogram));
+
+  // the target labels are kept when the domains are enabled
+  matcher.setUseDomains(true);
+  EXPECT_TRUE(matcher.targetInvariants().hasLabels());
+  EXPECT_EQ(0, matcher.countMatches(0));
+  EXPECT_EQ(2, matcher.screen().numRejected(Screen::LabelHistogram));
+
+  // without target labels, the histograms are not compared
+  matcher.setTarget(target);
+  EXPECT_FALSE(matcher.targetInvariants().hasLabels());
+  EXPECT_TRUE(matcher.hasMatch(0));
+  EXPECT_EQ(2, matcher.screen().numRejected(Screen::LabelHistogram));
+}
+
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
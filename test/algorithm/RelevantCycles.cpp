@@ -530,6 +530,82 @@ TYPED_TEST(RelevantCyclesTest, BergerFig8b)
   }));
 }
 
+TYPED_TEST(RelevantCyclesTest, ShortestPathDAG)
+{
+  using Graph = TypeParam;
+
+  // 6-ring, the only family has r = 5, p, q = 1, 3 and x = 2
+  auto g = ocgl::GraphStringParser<Graph>::parse("*1*****1");
+  auto V = ocgl::getVertices(g).toVector();
+
+  auto families = ocgl::algorithm::impl::initialCycleFamilies(g);
+  ASSERT_EQ(1, families.size());
+
+  auto &family = families.front();
+  EXPECT_TRUE(family.isEven());
+  EXPECT_EQ(V[5], family.r());
+  EXPECT_EQ(V[2], family.x());
+
+  // Dr only stores the shortest path edges
+  auto &Dr = family.Dr();
+  EXPECT_EQ(6, Dr.numVertices());
+  EXPECT_EQ(6, Dr.numEdges());
+  EXPECT_EQ(V[2], Dr.vertex(Dr.localIndex(V[2])));
+  EXPECT_EQ(std::vector<ocgl::Index>({Dr.localIndex(V[1]), Dr.localIndex(V[3])}),
+      Dr.predecessors(Dr.localIndex(V[2])).toVector());
+  EXPECT_EQ(0, Dr.predecessors(Dr.localIndex(V[5])).size());
+
+  std::vector<ocgl::VertexCycle<Graph>> cycles;
+  family.enumerate([&cycles] (const ocgl::VertexCycle<Graph> &cycle) {
+    cycles.push_back(cycle);
+  });
+  ASSERT_EQ(1, cycles.size());
+  EXPECT_EQ(6, cycles.front().size());
+}
+
+TYPED_TEST(RelevantCyclesTest, Parallel)
+{
+  using Graph = TypeParam;
+
+  std::vector<std::string> strs = {
+    "*1*(**2)***2****(**3)***31",
+    "*123*45*67*18*69*741*52*1983",
+    "*1**2*3*4*5*16.*2345623456.*12*3*4*5*16.**",
+    "*1*****1.*1***1.*1*(**2)***2****(**3)***31.*123*45*67*18*69*741*52*1983"
+  };
+
+  for (auto &str : strs) {
+    auto g = ocgl::GraphStringParser<Graph>::parse(str);
+    auto cycles = ocgl::algorithm::relevantCycles(g);
+
+    for (unsigned int numThreads = 1; numThreads <= 4; ++numThreads)
+      EXPECT_EQ(cycles, ocgl::algorithm::relevantCyclesParallel(g, numThreads));
+  }
+}
+
+TYPED_TEST(RelevantCyclesTest, SelectParallel)
+{
+  using Graph = TypeParam;
+
+  auto g = ocgl::GraphStringParser<Graph>::parse(
+      "*1*(**2)***2****(**3)***31.*123*45*67*18*69*741*52*1983");
+  auto rank = ocgl::circuitRank(g);
+
+  auto families = ocgl::algorithm::impl::initialCycleFamilies(g);
+  ocgl::algorithm::impl::selectRelevantCycleFamilies(g, rank, families);
+
+  for (unsigned int numThreads = 1; numThreads <= 4; ++numThreads) {
+    // always check in parallel
+    auto parallelFamilies = ocgl::algorithm::impl::initialCycleFamilies(g);
+    ocgl::algorithm::impl::selectRelevantCycleFamiliesParallel(g, rank,
+        parallelFamilies, numThreads, 0);
+
+    ASSERT_EQ(families.size(), parallelFamilies.size());
+    for (std::size_t i = 0; i < families.size(); ++i)
+      EXPECT_EQ(families[i].prototype(), parallelFamilies[i].prototype());
+  }
+}
+
 int main(int argc, char **argv)
 {
   ::testing::InitGoogleTest(&argc, argv);
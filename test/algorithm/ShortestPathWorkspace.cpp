@@ -0,0 +1,72 @@
+#include <ocgl/algorithm/ShortestPathWorkspace.h>
+#include <ocgl/algorithm/BFSShortestPaths.h>
+
+#include "../test.h"
+
+GRAPH_TYPED_TEST(ShortestPathWorkspaceTest);
+
+TYPED_TEST(ShortestPathWorkspaceTest, BFS)
+{
+  using Graph = TypeParam;
+
+  auto g = ocgl::GraphStringParser<Graph>::parse("*1****2*1***2");
+
+  // the same workspace is reused for all sources
+  ocgl::algorithm::ShortestPathWorkspace<Graph> paths;
+
+  for (auto s : ocgl::getVertices(g)) {
+    ocgl::algorithm::BFSShortestPaths<Graph> bfs(g, s);
+    paths.bfs(g, s);
+
+    EXPECT_EQ(s, paths.source());
+    EXPECT_EQ(ocgl::numVertices(g), paths.reached().size());
+
+    for (auto v : ocgl::getVertices(g)) {
+      EXPECT_TRUE(paths.isReached(v));
+      EXPECT_EQ(bfs.distance(v), paths.distance(v));
+      EXPECT_EQ(bfs.prev()[v], paths.prev(v));
+      EXPECT_EQ(bfs.path(v), paths.path(v));
+      EXPECT_EQ(bfs.reversePath(v), paths.reversePath(v));
+    }
+  }
+}
+
+TYPED_TEST(ShortestPathWorkspaceTest, Filter)
+{
+  using Graph = TypeParam;
+  using Vertex = typename ocgl::GraphTraits<Graph>::Vertex;
+
+  auto g = ocgl::GraphStringParser<Graph>::parse("*1****1.*");
+  auto V = ocgl::getVertices(g).toVector();
+
+  ocgl::algorithm::ShortestPathWorkspace<Graph> paths;
+
+  // first search reaches all vertices in the ring
+  paths.bfs(g, V[0]);
+  EXPECT_EQ(1, paths.distance(V[1]));
+  EXPECT_EQ(paths.infinity(), paths.distance(V[5]));
+
+  // second search must not see the stamps from the first search
+  ocgl::VertexPropertyMap<Graph, bool> mask(g, true);
+  mask[V[1]] = false;
+  paths.bfs(g, V[0], mask);
+
+  EXPECT_FALSE(paths.isReached(V[1]));
+  EXPECT_EQ(paths.infinity(), paths.distance(V[1]));
+  EXPECT_EQ(ocgl::nullVertex<Graph>(), paths.prev(V[1]));
+  EXPECT_EQ(3, paths.distance(V[2]));
+  EXPECT_EQ(std::vector<Vertex>({V[0], V[4], V[3], V[2]}), paths.path(V[2]));
+
+  // filter function
+  paths.bfs(g, V[2], [&g] (Vertex v) { return ocgl::getVertexIndex(g, v) <= 2; });
+
+  EXPECT_EQ(std::vector<Vertex>({V[2], V[1], V[0]}), paths.reached());
+  EXPECT_EQ(2, paths.distance(V[0]));
+  EXPECT_EQ(paths.infinity(), paths.distance(V[3]));
+}
+
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,119 @@
+#include <ocgl/algorithm/SubgraphInvariants.h>
+
+#include "../test.h"
+
+GRAPH_TYPED_TEST(SubgraphInvariantsTest);
+
+TYPED_TEST(SubgraphInvariantsTest, Compute)
+{
+  auto g = ocgl::GraphStringParser<TypeParam>::parse("**(*)(*)*");
+  ocgl::algorithm::SubgraphInvariants invariants(g);
+
+  EXPECT_EQ(5, invariants.numVertices());
+  EXPECT_EQ(4, invariants.numEdges());
+  EXPECT_EQ(5, invariants.numVerticesWithMinDegree(0));
+  EXPECT_EQ(5, invariants.numVerticesWithMinDegree(1));
+  EXPECT_EQ(1, invariants.numVerticesWithMinDegree(2));
+  EXPECT_EQ(1, invariants.numVerticesWithMinDegree(4));
+  EXPECT_EQ(0, invariants.numVerticesWithMinDegree(5));
+
+  // reuse for another graph
+  invariants.compute(ocgl::GraphStringParser<TypeParam>::parse("*.*"));
+  EXPECT_EQ(2, invariants.numVertices());
+  EXPECT_EQ(0, invariants.numEdges());
+  EXPECT_EQ(2, invariants.numVerticesWithMinDegree(0));
+  EXPECT_EQ(0, invariants.numVerticesWithMinDegree(1));
+}
+
+TYPED_TEST(SubgraphInvariantsTest, MayContain)
+{
+  auto mayContain = [] (const std::string &targetGS, const std::string &queryGS) {
+    ocgl::algorithm::SubgraphInvariants target(
+        ocgl::GraphStringParser<TypeParam>::parse(targetGS));
+    ocgl::algorithm::SubgraphInvariants query(
+        ocgl::GraphStringParser<TypeParam>::parse(queryGS));
+    return target.mayContain(query);
+  };
+
+  EXPECT_TRUE(mayContain("*", ""));
+  EXPECT_TRUE(mayContain("***", "**"));
+  EXPECT_TRUE(mayContain("*1*****1", "******"));
+  EXPECT_TRUE(mayContain("**(*)(*)*", "**(*)*"));
+
+  // counts
+  EXPECT_FALSE(mayContain("*", "**"));
+  EXPECT_FALSE(mayContain("*.*", "**"));
+  // degree 3 vertex
+  EXPECT_FALSE(mayContain("*1*****1", "**(*)*"));
+  // 2 degree 3 vertices
+  EXPECT_FALSE(mayContain("**(*)****(*)*", "*1***2**12"));
+  EXPECT_FALSE(mayContain("*1*****1", "*(*)*(*)*"));
+}
+
+TYPED_TEST(SubgraphInvariantsTest, Cycles)
+{
+  auto g = ocgl::GraphStringParser<TypeParam>::parse("*1***1**.*1**1");
+  ocgl::algorithm::SubgraphInvariants invariants(g);
+  EXPECT_FALSE(invariants.hasCycles());
+
+  invariants.computeCycles(g);
+  EXPECT_TRUE(invariants.hasCycles());
+  EXPECT_EQ(7, invariants.numCyclicVertices());
+  EXPECT_EQ(7, invariants.numCyclicEdges());
+
+  // compute() clears the cycle counts
+  auto chain = ocgl::GraphStringParser<TypeParam>::parse("******");
+  invariants.compute(chain);
+  EXPECT_FALSE(invariants.hasCycles());
+  invariants.computeCycles(chain);
+  EXPECT_EQ(0, invariants.numCyclicVertices());
+  EXPECT_EQ(0, invariants.numCyclicEdges());
+
+  // the chain passes the degree test, but has no ring
+  auto ring = ocgl::GraphStringParser<TypeParam>::parse("*1***1");
+  ocgl::algorithm::SubgraphInvariants query(ring);
+  EXPECT_TRUE(invariants.mayContain(query));
+  query.computeCycles(ring);
+  EXPECT_TRUE(invariants.mayContainDegrees(query));
+  EXPECT_FALSE(invariants.mayContainCycles(query));
+  EXPECT_FALSE(invariants.mayContain(query));
+}
+
+TYPED_TEST(SubgraphInvariantsTest, Labels)
+{
+  auto g = ocgl::GraphStringParser<TypeParam>::parse("******");
+  auto label = [&g] (unsigned int max) {
+    return [&g, max] (typename ocgl::GraphTraits<TypeParam>::Vertex v) {
+      return std::min(ocgl::getVertexIndex(g, v), max);
+    };
+  };
+
+  ocgl::algorithm::SubgraphInvariants target(g);
+  target.computeLabels(g, label(2));
+  EXPECT_TRUE(target.hasLabels());
+  EXPECT_EQ(1, target.numVerticesWithLabel(0));
+  EXPECT_EQ(1, target.numVerticesWithLabel(1));
+  EXPECT_EQ(4, target.numVerticesWithLabel(2));
+  EXPECT_EQ(0, target.numVerticesWithLabel(3));
+
+  ocgl::algorithm::SubgraphInvariants query(g);
+  EXPECT_TRUE(target.mayContainLabels(query));
+  query.computeLabels(g, label(5));
+  EXPECT_FALSE(target.mayContainLabels(query));
+  EXPECT_FALSE(target.mayContain(query));
+
+  auto small = ocgl::GraphStringParser<TypeParam>::parse("****");
+  ocgl::algorithm::SubgraphInvariants smallQuery(small);
+  smallQuery.computeLabels(small, [&small] (
+        typename ocgl::GraphTraits<TypeParam>::Vertex v) {
+    return std::min(ocgl::getVertexIndex(small, v), 2u);
+  });
+  EXPECT_TRUE(target.mayContainLabels(smallQuery));
+  EXPECT_FALSE(smallQuery.mayContainLabels(target));
+}
+
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,109 @@
+#include <ocgl/algorithm/SubgraphScreen.h>
+
+#include "../test.h"
+
+GRAPH_TYPED_TEST(SubgraphScreenTest);
+
+TYPED_TEST(SubgraphScreenTest, Counters)
+{
+  using Screen = ocgl::algorithm::SubgraphScreen;
+
+  auto invariants = [] (const std::string &gs) {
+    auto g = ocgl::GraphStringParser<TypeParam>::parse(gs);
+    ocgl::algorithm::SubgraphInvariants result(g);
+    result.computeCycles(g);
+    return result;
+  };
+
+  auto target = invariants("******");
+
+  Screen screen;
+  EXPECT_TRUE(screen.mayContain(target, invariants("***")));
+  EXPECT_FALSE(screen.mayContain(target, invariants("*******")));
+  EXPECT_FALSE(screen.mayContain(target, invariants("*1*****1")));
+  EXPECT_FALSE(screen.mayContain(target, invariants("**(*)*")));
+  EXPECT_FALSE(screen.mayContain(target, invariants("*1***1")));
+  EXPECT_FALSE(screen.mayContain(target, invariants("*1**1")));
+
+  EXPECT_EQ(6, screen.numTested());
+  EXPECT_EQ(1, screen.numPassed());
+  EXPECT_EQ(5, screen.numRejected());
+  EXPECT_EQ(1, screen.numRejected(Screen::VertexCount));
+  EXPECT_EQ(1, screen.numRejected(Screen::EdgeCount));
+  EXPECT_EQ(1, screen.numRejected(Screen::DegreeSequence));
+  EXPECT_EQ(2, screen.numRejected(Screen::CycleCount));
+  EXPECT_EQ(0, screen.numRejected(Screen::LabelHistogram));
+  EXPECT_EQ(0, screen.numRejected(Screen::Custom));
+
+  screen.resetCounters();
+  EXPECT_EQ(0, screen.numTested());
+  EXPECT_EQ(0, screen.numRejected());
+}
+
+TYPED_TEST(SubgraphScreenTest, Configure)
+{
+  using Screen = ocgl::algorithm::SubgraphScreen;
+
+  auto g = ocgl::GraphStringParser<TypeParam>::parse("******");
+  auto ring = ocgl::GraphStringParser<TypeParam>::parse("*1***1");
+  ocgl::algorithm::SubgraphInvariants target(g), query(ring);
+  target.computeCycles(g);
+  query.computeCycles(ring);
+
+  Screen screen;
+  EXPECT_TRUE(screen.isEnabled(Screen::CycleCount));
+  EXPECT_FALSE(screen.mayContain(target, query));
+
+  // a disabled test never rejects
+  screen.setEnabled(Screen::CycleCount, false);
+  EXPECT_FALSE(screen.isEnabled(Screen::CycleCount));
+  EXPECT_TRUE(screen.mayContain(target, query));
+
+  // custom tests run after the built-in tests
+  screen.addTest([] (const ocgl::algorithm::SubgraphInvariants &t,
+        const ocgl::algorithm::SubgraphInvariants &q) {
+    return 2 * q.numVertices() <= t.numVertices();
+  });
+  EXPECT_FALSE(screen.mayContain(target, query));
+  EXPECT_EQ(1, screen.numRejected(Screen::Custom));
+  EXPECT_EQ(1, screen.numRejected(Screen::CycleCount));
+  EXPECT_EQ(3, screen.numTested());
+
+  screen.setEnabled(Screen::Custom, false);
+  EXPECT_TRUE(screen.mayContain(target, query));
+}
+
+TYPED_TEST(SubgraphScreenTest, CycleStep)
+{
+  using Screen = ocgl::algorithm::SubgraphScreen;
+
+  auto g = ocgl::GraphStringParser<TypeParam>::parse("*1***1**");
+  auto ring = ocgl::GraphStringParser<TypeParam>::parse("*1****1");
+  ocgl::algorithm::SubgraphInvariants target(g), query(ring);
+  query.computeCycles(ring);
+
+  // the cycle test passes until the target's cycles are computed
+  Screen screen;
+  EXPECT_TRUE(screen.mayContain(target, query));
+  target.computeCycles(g);
+  EXPECT_FALSE(screen.mayContainCycles(target, query));
+
+  EXPECT_EQ(1, screen.numTested());
+  EXPECT_EQ(0, screen.numPassed());
+  EXPECT_EQ(1, screen.numRejected(Screen::CycleCount));
+
+  Screen other;
+  EXPECT_FALSE(other.mayContain(target, query));
+  EXPECT_TRUE(other.mayContain(target, ocgl::algorithm::SubgraphInvariants(g)));
+
+  screen.mergeCounters(other);
+  EXPECT_EQ(3, screen.numTested());
+  EXPECT_EQ(1, screen.numPassed());
+  EXPECT_EQ(2, screen.numRejected(Screen::CycleCount));
+}
+
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
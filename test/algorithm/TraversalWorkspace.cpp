@@ -0,0 +1,141 @@
+#include <ocgl/algorithm/TraversalWorkspace.h>
+#include <ocgl/algorithm/BFS.h>
+#include <ocgl/algorithm/CycleMembership.h>
+#include <ocgl/Cycle.h>
+
+#include "../test.h"
+
+#include <limits>
+
+GRAPH_TYPED_TEST(TraversalWorkspaceTest);
+
+TYPED_TEST(TraversalWorkspaceTest, Start)
+{
+  auto g = ocgl::GraphStringParser<TypeParam>::parse("***");
+  auto v = ocgl::getVertex(g, 1);
+  auto e = ocgl::getEdge(g, 0);
+
+  ocgl::algorithm::TraversalWorkspace<TypeParam> workspace;
+  workspace.start(g);
+  EXPECT_FALSE(workspace.isVertexVisited(v));
+  EXPECT_FALSE(workspace.isEdgeVisited(e));
+
+  workspace.visitVertex(v);
+  workspace.visitEdge(e);
+  EXPECT_TRUE(workspace.isVertexVisited(v));
+  EXPECT_TRUE(workspace.isEdgeVisited(e));
+  EXPECT_FALSE(workspace.isVertexVisited(ocgl::getVertex(g, 0)));
+  EXPECT_FALSE(workspace.isEdgeVisited(ocgl::getEdge(g, 1)));
+
+  // a new traversal does not see the old markers
+  workspace.start(g);
+  EXPECT_FALSE(workspace.isVertexVisited(v));
+  EXPECT_FALSE(workspace.isEdgeVisited(e));
+
+  // grow for a larger graph
+  auto h = ocgl::GraphStringParser<TypeParam>::parse("*1*****1");
+  workspace.start(h);
+  for (auto w : ocgl::getVertices(h))
+    EXPECT_FALSE(workspace.isVertexVisited(w));
+  for (auto f : ocgl::getEdges(h))
+    EXPECT_FALSE(workspace.isEdgeVisited(f));
+}
+
+TYPED_TEST(TraversalWorkspaceTest, Algorithms)
+{
+  ocgl::algorithm::TraversalWorkspace<TypeParam> workspace;
+
+  // same workspace for graphs of different sizes
+  for (const auto &gs : {"*1*****1**(*)*.*1**1", "*", "", "*1***2*****2*1",
+      "**.*.***", "*1***1"}) {
+    auto g = ocgl::GraphStringParser<TypeParam>::parse(gs);
+
+    auto cyclic1 = ocgl::algorithm::cycleMembership(g);
+    auto cyclic2 = ocgl::algorithm::cycleMembership(g, workspace);
+    for (auto v : ocgl::getVertices(g))
+      EXPECT_EQ(cyclic1.vertices[v], cyclic2.vertices[v]);
+    for (auto e : ocgl::getEdges(g))
+      EXPECT_EQ(cyclic1.edges[e], cyclic2.edges[e]);
+
+    auto components1 = ocgl::algorithm::connectedComponents(g);
+    auto components2 = ocgl::algorithm::connectedComponents(g, workspace);
+    for (auto v : ocgl::getVertices(g))
+      EXPECT_EQ(components1.vertices[v], components2.vertices[v]);
+
+    EXPECT_EQ(ocgl::algorithm::numConnectedComponents(g),
+        ocgl::algorithm::numConnectedComponents(g, workspace));
+    EXPECT_EQ(ocgl::circuitRank(g), ocgl::circuitRank(g, workspace));
+  }
+}
+
+TYPED_TEST(TraversalWorkspaceTest, BFS)
+{
+  struct CountVisitor : public ocgl::algorithm::BFSVisitor<TypeParam>
+  {
+    void vertex(const TypeParam&, typename ocgl::GraphTraits<TypeParam>::Vertex,
+        unsigned int)
+    {
+      ++numVertices;
+    }
+
+    void nonTreeEdge(const TypeParam&, typename ocgl::GraphTraits<TypeParam>::Edge)
+    {
+      ++numNonTreeEdges;
+    }
+
+    unsigned int numVertices = 0;
+    unsigned int numNonTreeEdges = 0;
+  };
+
+  ocgl::algorithm::TraversalWorkspace<TypeParam> workspace;
+  auto g = ocgl::GraphStringParser<TypeParam>::parse("*1***2*****2*1.**");
+
+  for (int i = 0; i < 3; ++i) {
+    CountVisitor visitor;
+    ocgl::algorithm::bfs(g, ocgl::getVertex(g, 0), visitor, workspace);
+    EXPECT_EQ(10, visitor.numVertices);
+    EXPECT_EQ(2, visitor.numNonTreeEdges);
+  }
+
+  CountVisitor visitor;
+  ocgl::algorithm::bfs(g, ocgl::getVertex(g, 0), visitor, workspace, 1);
+  EXPECT_EQ(3, visitor.numVertices);
+
+  // only the vertices in the mask are discovered
+  ocgl::VertexPropertyMap<TypeParam, bool> mask(g, false);
+  for (unsigned int i = 0; i < 3; ++i)
+    mask[ocgl::getVertex(g, i)] = true;
+  CountVisitor maskVisitor;
+  ocgl::algorithm::bfs(g, std::vector<typename ocgl::GraphTraits<TypeParam>::Vertex>(
+        1, ocgl::getVertex(g, 0)), maskVisitor, mask, workspace);
+  EXPECT_EQ(3, maskVisitor.numVertices);
+  EXPECT_EQ(0, maskVisitor.numNonTreeEdges);
+}
+
+TYPED_TEST(TraversalWorkspaceTest, EpochWraparound)
+{
+  // start right before the epoch wraps around
+  ocgl::algorithm::impl::StampedMarkers markers(
+      std::numeric_limits<unsigned int>::max() - 1);
+  markers.resize(3);
+  markers.clear();
+  markers.mark(0);
+  EXPECT_TRUE(markers.isMarked(0));
+  EXPECT_FALSE(markers.isMarked(1));
+
+  // the stamps are reset, unmarked indices (stamp 0) stay unmarked
+  markers.clear();
+  EXPECT_EQ(1, markers.epoch());
+  for (std::size_t i = 0; i < markers.size(); ++i)
+    EXPECT_FALSE(markers.isMarked(i));
+
+  markers.mark(2);
+  EXPECT_TRUE(markers.isMarked(2));
+  EXPECT_FALSE(markers.isMarked(0));
+}
+
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
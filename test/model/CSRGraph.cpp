@@ -0,0 +1,152 @@
+#include <ocgl/model/CSRGraph.h>
+#include <ocgl/algorithm/ConnectedComponents.h>
+#include <ocgl/algorithm/CycleMembership.h>
+#include <ocgl/algorithm/RelevantCycles.h>
+#include <ocgl/algorithm/Isomorphisms.h>
+
+#include "../test.h"
+
+using ocgl::model::IndexGraph;
+using ocgl::model::CSRGraph;
+
+//    3  6
+//    |  |
+// 2--0--1--5
+//    |  |
+//    4  7
+CSRGraph makeTestGraph()
+{
+  std::vector<std::pair<ocgl::VertexIndex, ocgl::VertexIndex>> edges = {
+    {0, 1}, {0, 2}, {0, 3}, {0, 4}, {1, 5}, {1, 6}, {1, 7}
+  };
+
+  return CSRGraph(8, edges);
+}
+
+TEST(CSRGraphTest, Empty)
+{
+  CSRGraph g;
+
+  EXPECT_EQ(0, ocgl::numVertices(g));
+  EXPECT_EQ(0, ocgl::numEdges(g));
+  EXPECT_EQ(0, ocgl::getVertices(g).size());
+  EXPECT_EQ(0, ocgl::getEdges(g).size());
+}
+
+TEST(CSRGraphTest, EdgeList)
+{
+  auto g = makeTestGraph();
+
+  EXPECT_EQ(8, ocgl::numVertices(g));
+  EXPECT_EQ(7, ocgl::numEdges(g));
+
+  EXPECT_EQ(4, ocgl::getDegree(g, 0));
+  EXPECT_EQ(4, ocgl::getDegree(g, 1));
+  for (ocgl::VertexIndex v = 2; v < 8; ++v)
+    EXPECT_EQ(1, ocgl::getDegree(g, v));
+
+  EXPECT_EQ(std::vector<ocgl::EdgeIndex>({0, 1, 2, 3}),
+      ocgl::getIncident(g, 0).toVector());
+  EXPECT_EQ(std::vector<ocgl::EdgeIndex>({0, 4, 5, 6}),
+      ocgl::getIncident(g, 1).toVector());
+  EXPECT_EQ(std::vector<ocgl::VertexIndex>({1, 2, 3, 4}),
+      ocgl::getAdjacent(g, 0).toVector());
+  EXPECT_EQ(std::vector<ocgl::VertexIndex>({0, 5, 6, 7}),
+      ocgl::getAdjacent(g, 1).toVector());
+  EXPECT_EQ(std::vector<ocgl::VertexIndex>({1}),
+      ocgl::getAdjacent(g, 7).toVector());
+
+  EXPECT_EQ(1, ocgl::getSource(g, 4));
+  EXPECT_EQ(5, ocgl::getTarget(g, 4));
+  EXPECT_EQ(1, ocgl::getOther(g, 4, 5));
+
+  EXPECT_EQ(2, ocgl::getEdge(g, 0, 3));
+  EXPECT_EQ(2, ocgl::getEdge(g, 3, 0));
+  EXPECT_TRUE(ocgl::isConnected(g, 1, 7));
+  EXPECT_FALSE(ocgl::isConnected(g, 0, 7));
+}
+
+TEST(CSRGraphTest, EdgeLookup)
+{
+  auto g = ocgl::GraphStringParser<IndexGraph>::parse("*1**2*(*)**1*2.**");
+  CSRGraph csr(g);
+  CSRGraph csrLookup(g, true);
+
+  EXPECT_FALSE(csr.hasEdgeLookup());
+  EXPECT_TRUE(csrLookup.hasEdgeLookup());
+
+  for (auto v : ocgl::getVertices(g))
+    for (auto w : ocgl::getVertices(g)) {
+      if (v == w)
+        continue;
+      EXPECT_EQ(ocgl::getEdge(g, v, w), ocgl::getEdge(csr, v, w));
+      EXPECT_EQ(ocgl::getEdge(g, v, w), ocgl::getEdge(csrLookup, v, w));
+      EXPECT_EQ(ocgl::isConnected(g, v, w), ocgl::isConnected(csrLookup, v, w));
+    }
+}
+
+TEST(CSRGraphTest, IndexGraph)
+{
+  auto g = ocgl::GraphStringParser<IndexGraph>::parse("*1**2*(*)**1*2.**");
+  CSRGraph csr(g);
+
+  ASSERT_EQ(ocgl::numVertices(g), ocgl::numVertices(csr));
+  ASSERT_EQ(ocgl::numEdges(g), ocgl::numEdges(csr));
+
+  for (auto v : ocgl::getVertices(g)) {
+    EXPECT_EQ(ocgl::getDegree(g, v), ocgl::getDegree(csr, v));
+    EXPECT_EQ(ocgl::getIncident(g, v).toVector(),
+        ocgl::getIncident(csr, v).toVector());
+    EXPECT_EQ(ocgl::getAdjacent(g, v).toVector(),
+        ocgl::getAdjacent(csr, v).toVector());
+  }
+
+  for (auto e : ocgl::getEdges(g)) {
+    EXPECT_EQ(ocgl::getSource(g, e), ocgl::getSource(csr, e));
+    EXPECT_EQ(ocgl::getTarget(g, e), ocgl::getTarget(csr, e));
+  }
+}
+
+TEST(CSRGraphTest, Algorithms)
+{
+  auto g = ocgl::GraphStringParser<IndexGraph>::parse(
+      "*1**2*3*4*5*16.*2345623456.*12*3*4*5*16.**");
+  CSRGraph csr(g);
+
+  auto components = ocgl::algorithm::connectedComponents(g);
+  auto csrComponents = ocgl::algorithm::connectedComponents(csr);
+  EXPECT_EQ(components.vertices.map(), csrComponents.vertices.map());
+  EXPECT_EQ(components.edges.map(), csrComponents.edges.map());
+
+  auto cyclic = ocgl::algorithm::cycleMembership(g);
+  auto csrCyclic = ocgl::algorithm::cycleMembership(csr);
+  EXPECT_EQ(cyclic.vertices.map(), csrCyclic.vertices.map());
+  EXPECT_EQ(cyclic.edges.map(), csrCyclic.edges.map());
+
+  EXPECT_EQ(ocgl::algorithm::relevantCycles(g),
+      ocgl::algorithm::relevantCycles(csr));
+
+  auto query = ocgl::GraphStringParser<IndexGraph>::parse("*1****1");
+  CSRGraph csrQuery(query);
+
+  int count = 0;
+  ocgl::algorithm::isomorphisms(query, g,
+      [&count] (const ocgl::VertexPropertyMap<IndexGraph, ocgl::VertexIndex>&) {
+        ++count;
+        return false;
+      });
+  int csrCount = 0;
+  ocgl::algorithm::isomorphisms(csrQuery, csr,
+      [&csrCount] (const ocgl::VertexPropertyMap<CSRGraph, ocgl::VertexIndex>&) {
+        ++csrCount;
+        return false;
+      });
+  EXPECT_LT(0, count);
+  EXPECT_EQ(count, csrCount);
+}
+
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
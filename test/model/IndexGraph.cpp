@@ -0,0 +1,126 @@
+#include <ocgl/model/IndexGraph.h>
+#include <ocgl/PropertyMap.h>
+#include <ocgl/algorithm/ConnectedComponents.h>
+
+#include "../test.h"
+
+using ocgl::model::IndexGraph;
+
+TEST(IndexGraphTest, TombstoneRemoveEdge)
+{
+  auto g = ocgl::GraphStringParser<IndexGraph>::parse("*1****1");
+  g.tombstones = true;
+
+  ocgl::removeEdge(g, 1);
+  ocgl::removeEdge(g, 3);
+
+  // indices are stable
+  EXPECT_EQ(5, ocgl::numVertices(g));
+  EXPECT_EQ(5, ocgl::numEdges(g));
+  EXPECT_EQ(2, g.numRemovedEdges);
+  EXPECT_TRUE(ocgl::model::is_removed_edge(g, 1));
+  EXPECT_TRUE(ocgl::model::is_removed_edge(g, 3));
+  EXPECT_FALSE(ocgl::model::is_removed_edge(g, 0));
+
+  EXPECT_EQ(std::vector<ocgl::EdgeIndex>({0, 2, 4}), ocgl::getEdges(g).toVector());
+  EXPECT_EQ(2, ocgl::getSource(g, 2));
+  EXPECT_EQ(3, ocgl::getTarget(g, 2));
+  EXPECT_EQ(1, ocgl::getDegree(g, 1));
+  EXPECT_EQ(1, ocgl::getDegree(g, 2));
+  EXPECT_FALSE(ocgl::isConnected(g, 1, 2));
+
+  ocgl::EdgePropertyMap<IndexGraph, int> labels(g);
+  for (auto e : ocgl::getEdges(g))
+    labels[e] = 10 + e;
+
+  auto remap = ocgl::model::compact(g);
+  ocgl::remapPropertyMap(labels, remap.edges);
+
+  EXPECT_EQ(5, ocgl::numVertices(g));
+  EXPECT_EQ(3, ocgl::numEdges(g));
+  EXPECT_EQ(0, g.numRemovedEdges);
+  EXPECT_EQ(std::vector<ocgl::EdgeIndex>({0, ocgl::nullEdge<IndexGraph>(), 1,
+        ocgl::nullEdge<IndexGraph>(), 2}), remap.edges);
+  EXPECT_EQ(std::vector<int>({10, 12, 14}), labels.map());
+
+  EXPECT_EQ(2, ocgl::getSource(g, 1));
+  EXPECT_EQ(3, ocgl::getTarget(g, 1));
+  EXPECT_EQ(std::vector<ocgl::EdgeIndex>({1}), ocgl::getIncident(g, 3).toVector());
+  EXPECT_EQ(std::vector<ocgl::EdgeIndex>({0, 2}), ocgl::getIncident(g, 0).toVector());
+}
+
+TEST(IndexGraphTest, TombstoneRemoveVertex)
+{
+  auto g = ocgl::GraphStringParser<IndexGraph>::parse("***.**");
+  g.tombstones = true;
+
+  ocgl::removeVertex(g, 1);
+
+  EXPECT_EQ(5, ocgl::numVertices(g));
+  EXPECT_EQ(3, ocgl::numEdges(g));
+  EXPECT_EQ(1, g.numRemovedVertices);
+  EXPECT_EQ(2, g.numRemovedEdges);
+  EXPECT_EQ(std::vector<ocgl::VertexIndex>({0, 2, 3, 4}), ocgl::getVertices(g).toVector());
+  EXPECT_EQ(std::vector<ocgl::EdgeIndex>({2}), ocgl::getEdges(g).toVector());
+  EXPECT_EQ(0, ocgl::getDegree(g, 0));
+  EXPECT_EQ(0, ocgl::getDegree(g, 2));
+
+  auto remap = ocgl::model::compact(g);
+
+  EXPECT_EQ(4, ocgl::numVertices(g));
+  EXPECT_EQ(1, ocgl::numEdges(g));
+  EXPECT_EQ(std::vector<ocgl::VertexIndex>({0, ocgl::nullVertex<IndexGraph>(), 1, 2, 3}),
+      remap.vertices);
+  EXPECT_EQ(2, ocgl::getSource(g, 0));
+  EXPECT_EQ(3, ocgl::getTarget(g, 0));
+  EXPECT_EQ(3, ocgl::algorithm::numConnectedComponents(g));
+
+  // new vertices and edges can be added after compacting
+  auto v = ocgl::addVertex(g);
+  ocgl::addEdge(g, v, 0);
+  EXPECT_EQ(5, ocgl::numVertices(g));
+  EXPECT_EQ(2, ocgl::numEdges(g));
+  EXPECT_EQ(3, ocgl::algorithm::numConnectedComponents(g));
+}
+
+TEST(IndexGraphTest, TombstoneRemoveTwice)
+{
+  auto g = ocgl::GraphStringParser<IndexGraph>::parse("****");
+  g.tombstones = true;
+
+  // removing a removed vertex or edge does nothing
+  ocgl::removeEdge(g, 0);
+  ocgl::removeEdge(g, 0);
+  ocgl::removeVertex(g, 2);
+  ocgl::removeVertex(g, 2);
+  ocgl::removeEdge(g, 1);
+
+  EXPECT_EQ(1, g.numRemovedVertices);
+  EXPECT_EQ(3, g.numRemovedEdges);
+  EXPECT_EQ(std::vector<ocgl::VertexIndex>({0, 1, 3}), ocgl::getVertices(g).toVector());
+  EXPECT_TRUE(ocgl::getEdges(g).toVector().empty());
+  EXPECT_EQ(0, ocgl::getDegree(g, 1));
+  EXPECT_EQ(0, ocgl::getDegree(g, 3));
+
+  auto remap = ocgl::model::compact(g);
+  EXPECT_EQ(3, ocgl::numVertices(g));
+  EXPECT_EQ(0, ocgl::numEdges(g));
+}
+
+TEST(IndexGraphTest, RemoveVertex)
+{
+  // both source and target indices need to be updated
+  auto g = ocgl::GraphStringParser<IndexGraph>::parse("*.**");
+
+  ocgl::removeVertex(g, 0);
+
+  EXPECT_EQ(2, ocgl::numVertices(g));
+  EXPECT_EQ(0, ocgl::getSource(g, 0));
+  EXPECT_EQ(1, ocgl::getTarget(g, 0));
+}
+
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}